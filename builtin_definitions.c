@@ -0,0 +1,139 @@
+#include "shell.h"
+
+/**
+ * alias_assignment - Parses one name=value alias assignment.
+ * @args: The remaining builtin arguments, starting with the assignment.
+ * @used: Set to the number of arguments consumed.
+ * Return: 0 on success, -1 on failure.
+ * Description: The line splitter doesn't know about quotes, so a quoted
+ * value may arrive as several arguments; they are joined back together
+ * until the quote closes, and the quotes are removed.
+ **/
+int alias_assignment(char **args, int *used)
+{
+	char value[MAX_CMD_LEN] = "";
+	char *eq = strchr(args[0], '=');
+	char quote;
+	size_t len;
+
+	*eq = '\0';
+	strncat(value, eq + 1, MAX_CMD_LEN - 1);
+	quote = (value[0] == '\'' || value[0] == '"') ? value[0] : '\0';
+	*used = 1;
+	while (quote != '\0' && strchr(value + 1, quote) == NULL &&
+			args[*used] != NULL)
+	{
+		strncat(value, " ", MAX_CMD_LEN - strlen(value) - 1);
+		strncat(value, args[(*used)++], MAX_CMD_LEN - strlen(value) - 1);
+	}
+	len = strlen(value);
+	if (quote != '\0' && len > 1 && value[len - 1] == quote)
+	{
+		value[len - 1] = '\0';
+		memmove(value, value + 1, len - 1);
+	}
+	return (define_alias(args[0], value));
+}
+
+/**
+ * execute_alias - Executes the 'alias' command
+ * @args: The arguments for the 'alias' command
+ * Description: Without arguments, lists every alias. NAME=VALUE defines
+ * an alias; NAME alone prints it.
+ */
+void execute_alias(char **args)
+{
+	def_entry *entry;
+	int i, used;
+
+	if (args[1] == NULL)
+	{
+		print_aliases();
+		return;
+	}
+	for (i = 1; args[i] != NULL; i += used)
+	{
+		used = 1;
+		if (strchr(args[i], '=') != NULL)
+		{
+			if (alias_assignment(args + i, &used) == -1)
+			{
+				write(STDERR_FILENO, "Failed to allocate memory\n", 26);
+				set_last_status(EXIT_FAILURE);
+			}
+			continue;
+		}
+		entry = def_lookup(args[i], 0);
+		if (entry != NULL && entry->alias != NULL)
+			printf("%s='%s'\n", entry->name, entry->alias);
+		else
+		{
+			fprintf(stderr, "alias: %s: not found\n", args[i]);
+			set_last_status(EXIT_FAILURE);
+		}
+		fflush(stdout);
+	}
+}
+
+/**
+ * execute_unalias - Executes the 'unalias' command
+ * @args: The arguments for the 'unalias' command
+ */
+void execute_unalias(char **args)
+{
+	int i;
+
+	if (args[1] == NULL)
+	{
+		write(STDERR_FILENO, "Usage: unalias NAME...\n", 23);
+		set_last_status(2);
+	}
+	for (i = 1; args[i] != NULL; i++)
+	{
+		if (define_alias(args[i], NULL) == -1)
+		{
+			fprintf(stderr, "unalias: %s: not found\n", args[i]);
+			set_last_status(EXIT_FAILURE);
+		}
+	}
+}
+
+/**
+ * execute_source - Executes the 'source' and '.' commands
+ * @args: The arguments for the command: the file, then its parameters
+ * @argv: The arguments that were passed to the shell
+ * @data: A pointer to the shell data
+ * @env: A pointer to the environment variables array
+ * Description: Runs the file in the current shell, so the functions,
+ * aliases and variables it defines stay available afterwards. return
+ * leaves the file early.
+ */
+void execute_source(char **args, char *argv[], shell_data *data, char **env)
+{
+	char **saved;
+	FILE *fd;
+
+	if (args[1] == NULL)
+	{
+		write(STDERR_FILENO, "Usage: source FILE [ARGS]\n", 26);
+		set_last_status(2);
+		return;
+	}
+	if (!nesting_enter(args[1], argv))
+		return;
+	fd = fopen(args[1], "r");
+	if (fd == NULL)
+	{
+		perror(args[1]);
+		set_last_status(EXIT_FAILURE);
+		nesting_leave();
+		return;
+	}
+	saved = args[2] != NULL ? swap_positional(args + 2) : NULL;
+	read_and_execute_commands(fd, argv, *data, env);
+	clear_jump(JUMP_RETURN);
+	if (args[2] != NULL)
+		swap_positional(saved);
+	fclose(fd);
+	nesting_leave();
+}
@@ -0,0 +1,38 @@
+#include "shell.h"
+
+/**
+ * run_shell_builtin - Runs the builtins for definitions, limits, shell
+ * options and control flow.
+ * @args: The command words.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: 1 if args[0] named one of these builtins and it was run, 0 if
+ * the caller should go on looking.
+ **/
+int run_shell_builtin(char **args, char *argv[], shell_data *data,
+		char **env)
+{
+	if (strcmp(args[0], "alias") == 0)
+		execute_alias(args);
+	else if (strcmp(args[0], "unalias") == 0)
+		execute_unalias(args);
+	else if (strcmp(args[0], "source") == 0 || strcmp(args[0], ".") == 0)
+		execute_source(args, argv, data, env);
+	else if (strcmp(args[0], "timeout") == 0)
+		execute_timeout(args, argv, data, env);
+	else if (strcmp(args[0], "ulimit") == 0)
+		execute_ulimit(args);
+	else if (strcmp(args[0], "set") == 0)
+		execute_set(args);
+	else if (strcmp(args[0], "exit") == 0)
+		execute_exit(args);
+	else if (strcmp(args[0], "break") == 0 ||
+			strcmp(args[0], "continue") == 0)
+		execute_break(args);
+	else if (strcmp(args[0], "return") == 0)
+		execute_return(args);
+	else
+		return (0);
+	return (1);
+}
@@ -0,0 +1,82 @@
+#include "shell.h"
+
+/**
+ * jump_number - Parses the numeric argument of exit, break or continue.
+ * @args: The command words.
+ * @value: Set to the number; left alone if there is no argument.
+ * @min: The smallest value allowed.
+ * Return: 0 on success, -1 after printing an error.
+ **/
+int jump_number(char **args, long *value, long min)
+{
+	char *end;
+	long n;
+
+	if (args[1] == NULL)
+		return (0);
+	errno = 0;
+	n = strtol(args[1], &end, 10);
+	if (end == args[1] || *end != '\0' || errno == ERANGE || n < min)
+	{
+		fprintf(stderr, "%s: Illegal number: %s\n", args[0], args[1]);
+		return (-1);
+	}
+	*value = n;
+	return (0);
+}
+
+/**
+ * execute_exit - Executes the 'exit' command
+ * @args: The arguments: [STATUS]
+ * Description: Leaves the shell with STATUS, or with the status of the
+ * last command. Blocks, loops and functions being run unwind first, so
+ * the caller of the script (or the daemon client) gets the status.
+ */
+void execute_exit(char **args)
+{
+	long status = get_last_status();
+
+	if (jump_number(args, &status, LONG_MIN) == -1)
+		status = 2;
+	set_last_status((int)(status & 0xff));
+	set_jump(JUMP_EXIT, 0);
+}
+
+/**
+ * execute_break - Executes the 'break' and 'continue' commands
+ * @args: The arguments: [N], the number of enclosing loops to leave
+ */
+void execute_break(char **args)
+{
+	long count = 1;
+
+	if (jump_number(args, &count, 1) == -1)
+	{
+		set_last_status(EXIT_FAILURE);
+		return;
+	}
+	set_jump(strcmp(args[0], "break") == 0 ? JUMP_BREAK : JUMP_CONTINUE,
+			(int)(count > INT_MAX ? INT_MAX : count));
+}
+
+/**
+ * execute_return - Executes the 'return' command
+ * @args: The arguments: [STATUS]
+ * Description: Leaves the running function or sourced file with STATUS,
+ * or with the status of the last command.
+ */
+void execute_return(char **args)
+{
+	long status = get_last_status();
+
+	if (nesting_depth() == 0)
+	{
+		fprintf(stderr, "return: not in a function or sourced file\n");
+		set_last_status(EXIT_FAILURE);
+		return;
+	}
+	if (jump_number(args, &status, LONG_MIN) == -1)
+		status = 2;
+	set_last_status((int)(status & 0xff));
+	set_jump(JUMP_RETURN, 0);
+}
@@ -0,0 +1,150 @@
+#include "shell.h"
+
+/**
+ * parse_duration - Parses a timeout duration.
+ * @s: The duration: a number, optionally fractional, followed by an
+ * optional s, m, h or d suffix.
+ * Return: The duration in milliseconds, or -1 if @s is not valid, not
+ * a finite number, or too long to count in milliseconds.
+ **/
+long parse_duration(const char *s)
+{
+	char *end;
+	double secs = strtod(s, &end);
+
+	if (end == s || secs < 0)
+		return (-1);
+	if (*end == 'm')
+		secs *= 60;
+	else if (*end == 'h')
+		secs *= 3600;
+	else if (*end == 'd')
+		secs *= 86400;
+	else if (*end != 's' && *end != '\0')
+		return (-1);
+	if (*end != '\0' && end[1] != '\0')
+		return (-1);
+	if (secs != secs || secs > (double)(LONG_MAX / 1000))
+		return (-1);
+	return ((long)(secs * 1000));
+}
+
+/**
+ * wait_child - Waits for a child process to exit, up to a time limit.
+ * @pid: The child process ID.
+ * @pidfd: A pidfd referring to the child, or -1 if there is none.
+ * @ms: The time limit in milliseconds.
+ * Return: 1 if the process exited, 0 if the time limit was reached.
+ * Description: The pidfd becomes readable when the process exits, so
+ * poll does the waiting; signals interrupting it don't extend the limit.
+ * Without a pidfd (kernels before 5.3), poll only sleeps in steps of
+ * TIMEOUT_POLL_STEP milliseconds between checks with waitid, which
+ * leaves the child for the caller to reap.
+ **/
+int wait_child(pid_t pid, int pidfd, long ms)
+{
+	struct pollfd pfd;
+	struct timespec start, now;
+	siginfo_t info;
+	long left = ms, step;
+	int ret;
+
+	pfd.fd = pidfd;
+	pfd.events = POLLIN;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (1)
+	{
+		step = (pidfd == -1 && left > TIMEOUT_POLL_STEP) ?
+			TIMEOUT_POLL_STEP : left;
+		ret = poll(&pfd, 1, step > INT_MAX ? INT_MAX : step);
+		info.si_pid = 0;
+		if (pidfd == -1)
+			waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT);
+		if (ret == 1 || info.si_pid == pid)
+			return (1);
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		left = ms - ((now.tv_sec - start.tv_sec) * 1000 +
+				(now.tv_nsec - start.tv_nsec) / 1000000);
+		if ((ret == 0 || errno == EINTR) && left > 0)
+			continue;
+		return (ret == -1 && errno != EINTR);
+	}
+}
+
+/**
+ * run_timed_child - Runs the command being timed in the forked child.
+ * @args: The command words.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Description: The child gets its own process group so the whole group
+ * can be signalled on timeout. External commands are exec'ed in place;
+ * builtins and functions run in the child. Never returns.
+ **/
+void run_timed_child(char **args, char *argv[], shell_data *data, char **env)
+{
+	setpgid(0, 0);
+	if (is_builtin(args[0]) || def_lookup(args[0], 0) != NULL)
+	{
+		execute_cmd(args, argv, data, env);
+		fflush(stdout);
+		_exit(get_last_status());
+	}
+	handle_child_process(args, argv, -1, env);
+}
+
+/**
+ * timeout_kill - Stops a timed-out process group.
+ * @pid: The process (and process group) ID.
+ * @pidfd: A pidfd referring to the process, or -1.
+ * Description: SIGTERM is sent first; if the process is still alive
+ * after TIMEOUT_KILL_AFTER milliseconds, SIGKILL follows.
+ **/
+void timeout_kill(pid_t pid, int pidfd)
+{
+	kill(-pid, SIGTERM);
+	if (!wait_child(pid, pidfd, TIMEOUT_KILL_AFTER))
+		kill(-pid, SIGKILL);
+}
+
+/**
+ * execute_timeout - Executes the 'timeout' command
+ * @args: The arguments: the duration, then the command to run
+ * @argv: The arguments that were passed to the shell
+ * @data: A pointer to the shell data
+ * @env: A pointer to the environment variables array
+ * Description: Waits on a pidfd with poll instead of spawning a watchdog
+ * process (see wait_child for kernels without pidfd_open). The status is 124 if the command timed out, 125 if timeout
+ * itself failed, and the command's status otherwise.
+ */
+void execute_timeout(char **args, char *argv[], shell_data *data, char **env)
+{
+	long ms = args[1] != NULL ? parse_duration(args[1]) : -1;
+	int pidfd, status, timed_out = 0;
+	pid_t pid;
+
+	if (ms < 0 || args[2] == NULL)
+	{
+		write(STDERR_FILENO, "Usage: timeout DURATION COMMAND [ARGS]\n", 39);
+		set_last_status(125);
+		return;
+	}
+	fflush(stdout);
+	pid = fork();
+	if (pid < 0)
+		handle_fork_error();
+	if (pid == 0)
+		run_timed_child(args + 2, argv, data, env);
+	setpgid(pid, pid);
+	pidfd = syscall(SYS_pidfd_open, pid, 0);
+	if (ms > 0 && !wait_child(pid, pidfd, ms))
+	{
+		timed_out = 1;
+		timeout_kill(pid, pidfd);
+	}
+	if (pidfd != -1)
+		close(pidfd);
+	if (waitpid(pid, &status, 0) == -1)
+		status = 125 << 8;
+	set_last_status(timed_out ? 124 : status_from_wait(status));
+}
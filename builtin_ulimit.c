@@ -0,0 +1,121 @@
+#include "shell.h"
+
+static child_limit child_limits[] = {
+	{'c', RLIMIT_CORE, 512, 0, 0},
+	{'d', RLIMIT_DATA, 1024, 0, 0},
+	{'f', RLIMIT_FSIZE, 512, 0, 0},
+	{'n', RLIMIT_NOFILE, 1, 0, 0},
+	{'s', RLIMIT_STACK, 1024, 0, 0},
+	{'t', RLIMIT_CPU, 1, 0, 0},
+	{'u', RLIMIT_NPROC, 1, 0, 0},
+	{'v', RLIMIT_AS, 1024, 0, 0},
+	{'\0', 0, 0, 0, 0}
+};
+
+/**
+ * find_limit - Looks up a ulimit option.
+ * @opt: The option letter.
+ * Return: The matching limit, or NULL if @opt is not supported.
+ **/
+child_limit *find_limit(char opt)
+{
+	int i;
+
+	for (i = 0; child_limits[i].opt != '\0'; i++)
+	{
+		if (child_limits[i].opt == opt)
+			return (&child_limits[i]);
+	}
+	return (NULL);
+}
+
+/**
+ * apply_child_limits - Applies the limits set with ulimit.
+ * Description: Called in a forked child just before it execs, so the
+ * shell itself keeps running with its own limits. Only the soft limit is
+ * changed unless the limit was set with -H.
+ **/
+void apply_child_limits(void)
+{
+	struct rlimit rl;
+	int i;
+
+	for (i = 0; child_limits[i].opt != '\0'; i++)
+	{
+		if (!child_limits[i].set ||
+				getrlimit(child_limits[i].resource, &rl) == -1)
+			continue;
+		rl.rlim_cur = child_limits[i].value;
+		if (child_limits[i].set == ULIMIT_HARD)
+			rl.rlim_max = child_limits[i].value;
+		if (setrlimit(child_limits[i].resource, &rl) == -1)
+			perror("ulimit");
+	}
+}
+
+/**
+ * print_limit - Prints the limit children will run with.
+ * @limit: The limit to print.
+ **/
+void print_limit(child_limit *limit)
+{
+	struct rlimit rl;
+	rlim_t value;
+
+	if (limit->set)
+		value = limit->value;
+	else if (getrlimit(limit->resource, &rl) == -1)
+	{
+		perror("ulimit");
+		return;
+	}
+	else
+		value = rl.rlim_cur;
+	if (value == RLIM_INFINITY)
+		printf("unlimited\n");
+	else
+		printf("%lu\n", (unsigned long)(value / limit->unit));
+	fflush(stdout);
+}
+
+/**
+ * execute_ulimit - Executes the 'ulimit' command
+ * @args: The arguments: [-H] [-c|-d|-f|-n|-s|-t|-u|-v] [VALUE|unlimited]
+ * Description: Without a value, prints the limit; -f is the default.
+ * Sizes are in the units other shells use (KiB, or 512-byte blocks for
+ * -c and -f). The limit applies to every command started afterwards;
+ * values that could not be applied are rejected with status 1.
+ */
+void execute_ulimit(char **args)
+{
+	child_limit *limit = find_limit('f');
+	int i, hard = 0;
+	rlim_t new_value;
+
+	for (i = 1; args[i] != NULL && args[i][0] == '-'; i++)
+	{
+		if (strcmp(args[i], "-H") == 0)
+			hard = 1;
+		else if (strcmp(args[i], "-S") != 0 &&
+				(args[i][1] == '\0' || args[i][2] != '\0' ||
+				 (limit = find_limit(args[i][1])) == NULL))
+		{
+			fprintf(stderr, "ulimit: %s: invalid option\n", args[i]);
+			set_last_status(2);
+			return;
+		}
+	}
+	if (args[i] == NULL)
+	{
+		print_limit(limit);
+		return;
+	}
+	if (parse_limit(args[i], limit, &new_value) == -1 ||
+			check_limit(limit, new_value, hard) == -1)
+	{
+		set_last_status(EXIT_FAILURE);
+		return;
+	}
+	limit->value = new_value;
+	limit->set = hard ? ULIMIT_HARD : ULIMIT_SOFT;
+}
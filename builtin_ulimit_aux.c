@@ -0,0 +1,63 @@
+#include "shell.h"
+
+/**
+ * parse_limit - Converts a ulimit value to the resource's own units.
+ * @arg: The value as given: a non-negative number or "unlimited".
+ * @limit: The limit being set.
+ * @value: Set to the converted value.
+ * Return: 0 on success, -1 after printing an error.
+ **/
+int parse_limit(const char *arg, child_limit *limit, rlim_t *value)
+{
+	unsigned long n;
+	char *end;
+
+	if (strcmp(arg, "unlimited") == 0)
+	{
+		*value = RLIM_INFINITY;
+		return (0);
+	}
+	errno = 0;
+	n = strtoul(arg, &end, 10);
+	if (*end != '\0' || end == arg || arg[0] < '0' || arg[0] > '9' ||
+			errno == ERANGE ||
+			(rlim_t)n >= RLIM_INFINITY / limit->unit)
+	{
+		fprintf(stderr, "ulimit: %s: invalid number\n", arg);
+		return (-1);
+	}
+	*value = (rlim_t)n * limit->unit;
+	return (0);
+}
+
+/**
+ * check_limit - Checks that a new limit can be applied.
+ * @limit: The limit being set.
+ * @value: The new value, in the resource's own units.
+ * @hard: Non-zero if the hard limit is being set.
+ * Return: 0 if the value is allowed, -1 after printing an error.
+ * Description: A soft limit can't exceed the hard limit, and only root
+ * can raise a hard limit, so such values are refused now rather than
+ * failing in every child that starts afterwards.
+ **/
+int check_limit(child_limit *limit, rlim_t value, int hard)
+{
+	struct rlimit rl;
+	rlim_t max;
+
+	if (getrlimit(limit->resource, &rl) == -1)
+	{
+		perror("ulimit");
+		return (-1);
+	}
+	max = (limit->set == ULIMIT_HARD) ? limit->value : rl.rlim_max;
+	if (max == RLIM_INFINITY || (value != RLIM_INFINITY && value <= max))
+		return (0);
+	if (!hard)
+		fprintf(stderr, "ulimit: value exceeds the hard limit\n");
+	else if (geteuid() != 0)
+		fprintf(stderr, "ulimit: cannot raise the hard limit\n");
+	else
+		return (0);
+	return (-1);
+}
@@ -7,7 +7,7 @@
  * directories. If no argument is provided, an error message is printed
  * to standard error. If an argument is provided, the chdir function is called
  * to change the current directory. If chdir fails, an error message is printed
- * to standard error.
+ * to standard error. Every failure sets the exit status to 1.
  **/
 
 void execute_cd_command(char *args[], char **env)
@@ -22,6 +22,7 @@ void execute_cd_command(char *args[], char **env)
 			perror("Write failed");
 			exit(EXIT_FAILURE);
 		}
+		set_last_status(EXIT_FAILURE);
 	}
 	else if (strcmp(args[1], "-") == 0)
 	{
@@ -35,19 +36,20 @@ void execute_cd_command(char *args[], char **env)
 				perror("Write failed");
 				exit(EXIT_FAILURE);
 			}
+			set_last_status(EXIT_FAILURE);
 		}
-		else
+		else if (chdir(oldpwd) != 0)
 		{
-			if (chdir(oldpwd) != 0)
-				perror("cd");
-			else
-				print_string(oldpwd);
+			perror("cd");
+			set_last_status(EXIT_FAILURE);
 		}
+		else
+			print_string(oldpwd);
 	}
-	else
+	else if (chdir(args[1]) != 0)
 	{
-		if (chdir(args[1]) != 0)
-			perror("cd");
+		perror("cd");
+		set_last_status(EXIT_FAILURE);
 	}
 }
 
@@ -56,36 +58,43 @@ void execute_cd_command(char *args[], char **env)
  * execute_command_in_path - Executes a command by
  * searching in the system's PATH.
  * @args: Array of command arguments.
- * @error_message: Error message buffer.
- * @length: Pointer to the length of the error message.
  * @env: The environment variables array
- * Description: This function searches for the command specified by
- * the first argument in the args array within the directories listed in the
- * system's PATH environment variable. If the command is found and
- * is executable it is executed using the execve function.
- * The error_message and length parameters are not used in this implementation.
+ * Description: Names containing a '/' are executed as they are. Other
+ * names are looked up in each directory of PATH in a single pass,
+ * trying execve directly rather than checking with access first; a
+ * directory where the command exists but can't be run is remembered so
+ * that the most useful error is reported, as execvp does. Files that
+ * aren't executables are run by /bin/sh (see exec_file).
+ * Return: Only returns if the command could not be executed, with the
+ * errno describing why.
  **/
-void execute_command_in_path(char *args[], char *error_message,
-		int *length, char **env)
+int execute_command_in_path(char *args[], char **env)
 {
 	char *path = getenv("PATH");
-	char *dir = strtok(path, ":");
-	char exec_path[MAX_CMD_LEN];
+	char exec_path[PATH_MAX];
+	size_t dir_len;
+	int err = ENOENT;
 
-	(void)error_message;
-	(void)length;
-	while (dir != NULL)
+	(void)env;
+	if (strchr(args[0], '/') != NULL || path == NULL)
+	{
+		return (exec_file(args[0], args));
+	}
+	while (path != NULL)
 	{
-		strcpy(exec_path, dir);
-		strcat(exec_path, "/");
-		strcat(exec_path, args[0]);
-		if (access(exec_path, X_OK) == 0)
+		dir_len = strcspn(path, ":");
+		if (snprintf(exec_path, sizeof(exec_path), "%.*s%s%s", (int)dir_len,
+					path, dir_len ? "/" : "", args[0]) < (int)sizeof(exec_path))
 		{
-			execve(exec_path, args, env);
-			break;
+			errno = exec_file(exec_path, args);
+			if (errno != ENOENT && errno != ENOTDIR)
+				err = errno;
+			if (errno != ENOENT && errno != ENOTDIR && errno != EACCES)
+				break;
 		}
-		dir = strtok(NULL, ":");
+		path = (path[dir_len] == ':') ? path + dir_len + 1 : NULL;
 	}
+	return (err);
 }
 
 /**
@@ -93,25 +102,24 @@ void execute_command_in_path(char *args[], char *error_message,
  * @args: Array of command arguments.
  * @argv: Array of command-line arguments.
  * @env: The environment variables array
- * Description: This function forks a new process and attempts to execute the
- * command specified by the first argument in the args array.
- * If the execution fails, it tries to find the command in the system's PATH
- * If the command is still not found, an error message is printed
- * The parent process waits for the childm process
- * to complete before continuing.
+ * Description: This function forks a new process which looks the command
+ * up in the PATH and executes it. The child reports a failed exec through
+ * a close-on-exec pipe: a successful exec closes the pipe without writing,
+ * a failure writes the errno. The parent reports the error itself, records
+ * the exit status and carries on with the next command either way.
  **/
 void execute_other_command(char *args[], char *argv[], char **env)
 {
-	int length = 0;
-	char error_message[1024];
+	int fds[2], err;
 	pid_t pid;
 
-	if (!command_exists(args[0], env))
+	if (pipe2(fds, O_CLOEXEC) == -1)
 	{
-		print_error_message(argv, args, error_message, length);
+		perror("pipe");
+		set_last_status(EXIT_FAILURE);
 		return;
 	}
-
+	fflush(stdout);
 	pid = fork();
 
 	if (pid < 0)
@@ -120,11 +128,17 @@ void execute_other_command(char *args[], char *argv[], char **env)
 	}
 	else if (pid == 0)
 	{
-		handle_child_process(args, argv, error_message, length, env);
+		close(fds[0]);
+		handle_child_process(args, argv, fds[1], env);
 	}
-	else
+	close(fds[1]);
+	err = read_exec_status(fds[0]);
+	close(fds[0]);
+	handle_parent_process(pid);
+	if (err != 0)
 	{
-		handle_parent_process(pid);
+		report_exec_error(argv, args, err);
+		set_last_status(exec_failure_status(err));
 	}
 }
 
@@ -134,42 +148,38 @@ void execute_other_command(char *args[], char *argv[], char **env)
  * @argv: The arguments for the command
  * @data: A pointer to the shell data
  * @env: A pointer to the environment variables array
+ * Description: Aliases and functions are looked up first, then builtins
+ * (see run_shell_builtin for the newer ones), then the PATH. Builtins
+ * succeed unless they set a failure status.
  */
 void execute_cmd(char **cmd, char *argv[], shell_data *data, char **env)
 {
-	char *args[MAX_CMD_LEN] = {NULL};
-	int i = 0;
-	(void)data;
+	char **args = cmd;
 
-	while (cmd[i] != NULL)
+	if (args[0] == NULL || run_definition(args, argv, data, env))
+		return;
+	set_last_status(EXIT_SUCCESS);
+	if (run_shell_builtin(args, argv, data, env))
+		return;
+	if (strncmp(args[0], "cd", 2) == 0)
 	{
-		args[i] = cmd[i];
-		i++;
+		execute_cd(args, env);
 	}
-	args[i] = NULL;
-
-	if (args[0])
+	else if (strncmp(args[0], "env", 3) == 0)
 	{
-		if (strncmp(args[0], "cd", 2) == 0)
-		{
-			execute_cd(args, env);
-		}
-		else if (strncmp(args[0], "env", 3) == 0)
-		{
-			execute_env(args, env);
-		}
-		else if (strncmp(args[0], "setenv", 6) == 0)
-		{
-			execute_setenv(args, env);
-		}
-		else if (strncmp(args[0], "unsetenv", 8) == 0)
-		{
-			execute_unsetenv(args, env);
-		}
-		else
-		{
-			execute_other_command(args, argv, env);
-		}
+		execute_env(args, env);
+	}
+	else if (strncmp(args[0], "setenv", 6) == 0)
+	{
+		execute_setenv(args, env);
+	}
+	else if (strncmp(args[0], "unsetenv", 8) == 0)
+	{
+		execute_unsetenv(args, env);
+	}
+	else
+	{
+		execute_other_command(args, argv, env);
 	}
 }
 
@@ -14,11 +14,14 @@ void execute_cd(char **args, char **env)
  * execute_env - Executes the 'env' command
  * @args: The arguments for the 'env' command
  * @env: A pointer to the environment variables array
+ * Description: The builtins work on the process environment (environ),
+ * which is also what loop variables and executed commands see.
  */
 void execute_env(char **args, char **env)
 {
 	(void)args;
-	print_env(env);
+	(void)env;
+	print_env(environ);
 }
 
 /**
@@ -28,13 +31,19 @@ void execute_env(char **args, char **env)
  */
 void execute_setenv(char **args, char **env)
 {
+	(void)env;
 	if (args[1] && args[2]) /* Check if VARIABLE and VALUE are provided */
 	{
-		set_env_var(args[1], args[2], &env);
+		if (setenv(args[1], args[2], 1) == -1)
+		{
+			perror("setenv");
+			set_last_status(EXIT_FAILURE);
+		}
 	}
 	else
 	{
 		write(STDERR_FILENO, "Usage: setenv VARIABLE VALUE\n", 29);
+		set_last_status(EXIT_FAILURE);
 	}
 }
 
@@ -45,13 +54,42 @@ void execute_setenv(char **args, char **env)
  */
 void execute_unsetenv(char **args, char **env)
 {
+	(void)env;
 	if (args[1]) /* Check if VARIABLE is provided */
 	{
-		unset_env_var(args[1], &env);
+		if (getenv(args[1]) == NULL)
+		{
+			fprintf(stderr,
+					"Error: Environment variable '%s' not found\n", args[1]);
+			set_last_status(EXIT_FAILURE);
+		}
+		else
+			unsetenv(args[1]);
 	}
 	else
 	{
 		write(STDERR_FILENO, "Usage: unsetenv VARIABLE\n", 25);
+		set_last_status(EXIT_FAILURE);
 	}
 }
 
+
+/**
+ * is_builtin - Checks whether a command name is a shell builtin
+ * @name: The command name
+ * Return: 1 if @name is handled by the shell itself, 0 otherwise
+ */
+int is_builtin(const char *name)
+{
+	const char *builtins[] = {"cd", "env", "setenv", "unsetenv", "alias",
+		"unalias", "source", ".", "timeout", "ulimit", "set", "exit",
+		"break", "continue", "return", NULL};
+	int i;
+
+	for (i = 0; builtins[i] != NULL; i++)
+	{
+		if (strcmp(name, builtins[i]) == 0)
+			return (1);
+	}
+	return (0);
+}
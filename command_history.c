@@ -7,13 +7,18 @@
  * into the node, and inserts the node at the beginning of the history list
  * If the history list exceeds the maximum count the oldest commands are
  * removed from the list.If memory allocation fails, an error message is
- * printed,and the program terminates.
+ * printed,and the program terminates. Nothing is recorded while history
+ * is disabled (script, -c and daemon modes).
  **/
 
 void insert_cmd(shell_data *data, const char *cmd)
 {
-	Node *newNode = (Node *)malloc(sizeof(Node));
+	Node *newNode;
 
+	if (data->history_state == HISTORY_OFF)
+		return;
+	data->history_dirty = 1;
+	newNode = (Node *)malloc(sizeof(Node));
 	if (newNode == NULL)
 	{
 		perror("Memory allocation failed");
@@ -74,121 +79,87 @@ void clear_history(shell_data *data)
  * write_history - Writes the command history to a file.
  * @data: Pointer to the shell_data struct.
  * Description: This function opens a file,writes each command
- * in the history list to the file, and closes the file.
+ * in the history list to the file, oldest first, and closes the file.
  * If any error occurs during the process, an error message
  * is printed and the function returns.
  **/
 void write_history(shell_data *data)
 {
+	Node *nodes[HISTORY_COUNT];
 	Node *current;
-	ssize_t len;
-	int fd;
+	FILE *fp;
+	int count = 0;
+
+	for (current = data->head; current != NULL && count < HISTORY_COUNT;
+			current = current->next)
+		nodes[count++] = current;
 
-	/* Open the file */
-	fd = open(HISTORY_FILE, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
-	if (fd == -1)
+	fp = fopen(HISTORY_FILE, "w");
+	if (fp == NULL)
 	{
 		perror("Failed to open history file for writing");
 		return;
 	}
-
-	current = data->head;
-	while (current != NULL)
+	while (count > 0)
 	{
-		/* Write the command to the file */
-		len = strlen(current->cmd);
-		if (write(fd, current->cmd, len) != len)
+		if (fprintf(fp, "%s\n", nodes[--count]->cmd) < 0)
 		{
 			perror("Failed to write command to history file");
-			close(fd);
-			return;
-		}
-
-		/* Write a newline character */
-		if (write(fd, "\n", 1) != 1)
-		{
-			perror("Failed to write newline to history file");
-			close(fd);
-			return;
+			break;
 		}
-
-		current = current->next;
 	}
-
-	/* Close the file */
-	if (close(fd) == -1)
+	if (fclose(fp) != 0)
 	{
 		perror("Failed to close history file");
 	}
 }
 /**
- * read_history - Reads command history from a file and
- * inserts it into the shell_data struct.
+ * read_history - Loads the command history file on first use.
  * @data: Pointer to the shell_data struct
- * Description: This function opens a history file,reads commands from it
- * removes newline characters, and inserts the commands into the history list
- * of the shell_data struct. If any error occurs during the process
- * an error message is printed and the function returns.
+ * Description: Does nothing unless history is enabled and not yet loaded,
+ * so it is safe to call before every lookup. Commands entered before the
+ * load are kept as the most recent entries. A missing history file simply
+ * means there is no history yet.
  **/
 void read_history(shell_data *data)
 {
 	char cmd[MAX_CMD_LEN];
-	ssize_t nread;
-	int fd;
+	Node *pending;
+	FILE *fp;
+	size_t len;
+	int dirty = data->history_dirty;
 
-	/* Open the file */
-	fd = open(HISTORY_FILE, O_RDONLY);
-	if (fd == -1)
-	{
-		perror("Failed to open history file for reading");
+	if (data->history_state != HISTORY_LAZY)
 		return;
-	}
-
-	/* Read the commands from the file */
-	while ((nread = read(fd, cmd, MAX_CMD_LEN)) > 0)
+	data->history_state = HISTORY_LOADED;
+	pending = data->head;
+	data->head = NULL;
+	fp = fopen(HISTORY_FILE, "r");
+	if (fp != NULL)
 	{
-		/* Remove the newline character, if present */
-		if (cmd[nread - 1] == '\n')
+		while (fgets(cmd, MAX_CMD_LEN, fp) != NULL)
 		{
-			cmd[nread - 1] = '\0';
+			len = strlen(cmd);
+			if (len > 0 && cmd[len - 1] == '\n')
+				cmd[len - 1] = '\0';
+			insert_cmd(data, cmd);
 		}
-		insert_cmd(data, cmd);
-	}
-
-	/* Close the file */
-	if (close(fd) == -1)
-	{
-		perror("Failed to close history file");
+		fclose(fp);
 	}
+	else if (errno != ENOENT)
+		perror("Failed to open history file for reading");
+	history_merge_pending(data, pending);
+	data->history_dirty = dirty;
 }
 
 /**
- * check_history_file - Checks if the history file exists
- * and creates it if necessary.
- * Description: This function checks if the history file exists
- * If the file doesn't exist, it creates the file with read and write
- * permissions for the user. If any error occurs during the process
- * an error message is printed, and the program terminates.
+ * check_history_file - Kept for callers of the old startup sequence.
+ * Description: History no longer touches the disk at startup: the file
+ * is read on first lookup by read_history and created by the first
+ * history_flush, so there is nothing to check here. The interactive
+ * loop still calls it, so it stays as an empty stub until that call is
+ * removed.
  **/
 void check_history_file(void)
 {
-	int fd;
-	/* Open the file */
-	fd = open(HISTORY_FILE, O_RDONLY);
-	if (fd == -1)
-	{
-		/* The file doesn't exist; create it */
-		fd = open(HISTORY_FILE, O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
-		if (fd == -1)
-		{
-			perror("Failed to create history file");
-			exit(EXIT_FAILURE);
-		}
-	}
-
-	/* Close the file */
-	if (close(fd) == -1)
-	{
-		perror("Failed to close history file");
-	}
 }
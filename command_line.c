@@ -0,0 +1,65 @@
+#include "shell.h"
+
+/**
+ * run_command_line - Runs one line of commands.
+ * @cmd: The command line.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Description: The line is split into commands and words first, and each
+ * word is expanded on its own ($NAME, $?, $(...)), so expanded text only
+ * ever becomes arguments and is never read again as shell syntax. Every
+ * line goes this way, so ';' lists, set -e and the jump builtins behave
+ * the same on a single line as in a block.
+ **/
+void run_command_line(char *cmd, char *argv[], shell_data *data, char **env)
+{
+	cf_node *tree;
+	int status;
+
+	tree = cf_parse(cmd, &status);
+	if (status != CF_OK)
+	{
+		write(STDERR_FILENO, "syntax error: unexpected token\n", 31);
+		set_last_status(2);
+		return;
+	}
+	cf_exec_list(tree, argv, data, env);
+	cf_free_tree(tree);
+}
+
+/**
+ * run_with_heredoc - Runs a command line that feeds a here-document or
+ * here-string to its stdin.
+ * @cmd: The command line containing the operator.
+ * @fd: The stream the line came from; here-document lines follow it.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Description: The operator is removed from the line, and the shell's
+ * stdin points at the content while the line runs, so builtins and
+ * children alike read it.
+ **/
+void run_with_heredoc(char *cmd, FILE *fd, char *argv[],
+		shell_data *data, char **env)
+{
+	char line[MAX_CMD_LEN];
+	char *op = heredoc_find(cmd), *rest, *body;
+	size_t len;
+	int in, saved;
+
+	body = heredoc_content(op, fd, &rest, &len, argv);
+	in = (body != NULL) ? heredoc_open(body, len) : -1;
+	free(body);
+	saved = (in != -1) ? stdin_replace(in) : -1;
+	if (saved == -1)
+	{
+		perror("here-document");
+		set_last_status(EXIT_FAILURE);
+		return;
+	}
+	*op = '\0';
+	snprintf(line, sizeof(line), "%s %s", cmd, rest);
+	run_command_line(line, argv, data, env);
+	stdin_restore(saved);
+}
@@ -0,0 +1,81 @@
+#include "shell.h"
+
+/**
+ * read_exec_status - Reads the exec result a child sent on its pipe.
+ * @fd: The read end of the close-on-exec status pipe.
+ * Return: 0 if the child exec'ed successfully (the pipe was closed
+ * without data), otherwise the errno of the failed exec.
+ **/
+int read_exec_status(int fd)
+{
+	int err = 0;
+	ssize_t n;
+
+	do {
+		n = read(fd, &err, sizeof(err));
+	} while (n == -1 && errno == EINTR);
+	return (n == sizeof(err) ? err : 0);
+}
+
+/**
+ * exec_failure_status - Maps a failed exec to an exit status.
+ * @err: The errno of the failed exec.
+ * Return: 127 if the command was not found, 126 otherwise.
+ **/
+int exec_failure_status(int err)
+{
+	return (err == ENOENT || err == ENOTDIR ? 127 : 126);
+}
+
+/**
+ * report_exec_error - Prints why a command could not be executed.
+ * @argv: The arguments that were passed to the shell.
+ * @args: The command words.
+ * @err: The errno of the failed exec.
+ * Description: "not found" keeps the usual message; other errors (such
+ * as a permission problem) are reported with their exact reason.
+ **/
+void report_exec_error(char *argv[], char *args[], int err)
+{
+	char error_message[1024];
+
+	if (exec_failure_status(err) == 127)
+	{
+		print_error_message(argv, args, error_message, 0);
+		return;
+	}
+	fprintf(stderr, "%s: 1: %s: %s\n", argv[0], args[0], strerror(err));
+}
+
+/**
+ * exec_file - Executes a file, falling back to /bin/sh for scripts.
+ * @file: The path of the file.
+ * @args: The command arguments; args[0] is the name it was called by.
+ * Return: Only returns if the file could not be executed, with the errno
+ * describing why.
+ * Description: A file the kernel can't execute (ENOEXEC, such as a
+ * script without a "#!" line) is run by /bin/sh with the same
+ * arguments, as execvp does.
+ **/
+int exec_file(char *file, char *args[])
+{
+	char **sh_args;
+	int n;
+
+	execve(file, args, environ);
+	if (errno != ENOEXEC)
+		return (errno);
+	for (n = 0; args[n] != NULL; n++)
+		;
+	sh_args = malloc(sizeof(char *) * (n + 2));
+	if (sh_args == NULL)
+		return (ENOEXEC);
+	sh_args[0] = "/bin/sh";
+	sh_args[1] = file;
+	memcpy(sh_args + 2, args + 1, sizeof(char *) * n);
+	execve(sh_args[0], sh_args, environ);
+	n = errno;
+	free(sh_args);
+	return (n);
+}
+
@@ -0,0 +1,126 @@
+#include "shell.h"
+
+/**
+ * substitution_end - Finds the end of a command substitution.
+ * @s: Pointer just past the opening "$(" or backtick.
+ * @open: '(' for $(...) or '`' for backticks.
+ * Return: Pointer to the closing character, or NULL if unterminated.
+ * Description: Parentheses nest, and text inside single or double quotes
+ * is skipped so that a quoted ')' doesn't end the substitution; a
+ * backslash-escaped character, even inside double quotes, is skipped too.
+ **/
+char *substitution_end(char *s, char open)
+{
+	int depth = 1;
+	char quote = '\0';
+
+	for (; *s != '\0'; s++)
+	{
+		if (quote != '\0')
+		{
+			if (quote == '"' && *s == '\\' && s[1] != '\0')
+				s++;
+			else if (*s == quote)
+				quote = '\0';
+		}
+		else if (*s == '\\' && s[1] != '\0')
+			s++;
+		else if (open == '`' && *s == '`')
+			return (s);
+		else if (*s == '\'' || *s == '"')
+			quote = *s;
+		else if (open == '(' && *s == '(')
+			depth++;
+		else if (open == '(' && *s == ')' && --depth == 0)
+			return (s);
+	}
+	return (NULL);
+}
+
+/**
+ * buf_append - Appends bytes to a growable buffer, keeping it terminated.
+ * @buf: Pointer to the buffer.
+ * @len: Pointer to the number of bytes used, excluding the terminator.
+ * @cap: Pointer to the allocated size of the buffer.
+ * @data: The bytes to append.
+ * @n: The number of bytes to append.
+ * Return: 0 on success, -1 if memory could not be allocated.
+ **/
+int buf_append(char **buf, size_t *len, size_t *cap,
+		const char *data, size_t n)
+{
+	char *tmp;
+	size_t new_cap;
+
+	if (*len + n + 1 > *cap)
+	{
+		new_cap = *cap * 2 + n + 1;
+		tmp = realloc(*buf, new_cap);
+		if (tmp == NULL)
+			return (-1);
+		*buf = tmp;
+		*cap = new_cap;
+	}
+	memcpy(*buf + *len, data, n);
+	*len += n;
+	(*buf)[*len] = '\0';
+	return (0);
+}
+
+/**
+ * append_split_output - Appends substitution output after word splitting.
+ * @buf: Pointer to the buffer.
+ * @len: Pointer to the number of bytes used.
+ * @cap: Pointer to the allocated size of the buffer.
+ * @out: The captured output.
+ * @sep: The byte put between the words of the output, or '\0' to keep
+ * the output as it is.
+ * Return: 0 on success, -1 if memory could not be allocated.
+ * Description: Trailing newlines are dropped. Unless @sep is '\0', every
+ * other run of spaces, tabs and newlines becomes a single @sep, so the
+ * words of the output become separate arguments on the command line.
+ **/
+int append_split_output(char **buf, size_t *len, size_t *cap, char *out,
+		char sep)
+{
+	size_t end = strlen(out);
+	size_t i, start;
+
+	while (end > 0 && out[end - 1] == '\n')
+		end--;
+	if (sep == '\0')
+		return (buf_append(buf, len, cap, out, end));
+	for (i = 0; i < end; )
+	{
+		start = i;
+		while (i < end && strchr(" \t\n", out[i]) == NULL)
+			i++;
+		if (buf_append(buf, len, cap, out + start, i - start) == -1)
+			return (-1);
+		if (i < end && buf_append(buf, len, cap, &sep, 1) == -1)
+			return (-1);
+		while (i < end && strchr(" \t\n", out[i]) != NULL)
+			i++;
+	}
+	return (0);
+}
+
+/**
+ * substitution_in_process - Checks whether a substitution can run in the
+ * shell itself.
+ * @cmd: The inner command text.
+ * Return: 1 if @cmd is a lone env or alias without arguments, which only
+ * print, 0 otherwise.
+ * Description: Everything else runs in a child process, so cd, setenv,
+ * definitions and the like inside $(...) never change the shell.
+ **/
+int substitution_in_process(char *cmd)
+{
+	char word[64] = "", extra[2] = "";
+
+	if (strpbrk(cmd, ";\n") != NULL)
+		return (0);
+	sscanf(cmd, "%63s %1s", word, extra);
+	return (extra[0] == '\0' &&
+			(strcmp(word, "env") == 0 || strcmp(word, "alias") == 0));
+}
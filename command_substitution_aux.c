@@ -0,0 +1,159 @@
+#include "shell.h"
+
+/**
+ * read_fd_all - Reads a descriptor until end of file.
+ * @fd: The descriptor to read from.
+ * Return: A malloc'ed, NUL-terminated copy of everything read, or NULL
+ * if memory could not be allocated.
+ **/
+char *read_fd_all(int fd)
+{
+	char chunk[4096];
+	char *buf = NULL;
+	size_t len = 0, cap = 0;
+	ssize_t n;
+
+	if (buf_append(&buf, &len, &cap, "", 0) == -1)
+		return (NULL);
+	while ((n = read(fd, chunk, sizeof(chunk))) != 0)
+	{
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n == -1)
+			break;
+		if (buf_append(&buf, &len, &cap, chunk, n) == -1)
+		{
+			free(buf);
+			return (NULL);
+		}
+	}
+	return (buf);
+}
+
+/**
+ * capture_builtin_output - Runs a printing builtin in-process and captures
+ * its stdout.
+ * @cmd: The command line to run.
+ * @argv: The arguments that were passed to the shell.
+ * @env: The environment variables array
+ * Return: The malloc'ed output, or NULL on failure.
+ * Description: stdout is pointed at an anonymous memory file for the
+ * duration of the builtin, so no process is created and the output never
+ * touches the disk.
+ **/
+char *capture_builtin_output(char *cmd, char *argv[], char **env)
+{
+	shell_data data = {NULL, HISTORY_OFF, 0, 0};
+	char *out;
+	int mfd, saved;
+
+	mfd = memfd_create("substitution", MFD_CLOEXEC);
+	if (mfd == -1)
+		return (NULL);
+	fflush(stdout);
+	saved = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0);
+	dup2(mfd, STDOUT_FILENO);
+	run_command_line(cmd, argv, &data, env);
+	fflush(stdout);
+	dup2(saved, STDOUT_FILENO);
+	close(saved);
+	lseek(mfd, 0, SEEK_SET);
+	out = read_fd_all(mfd);
+	close(mfd);
+	return (out);
+}
+
+/**
+ * run_substitution_child - Runs the inner commands in the forked child.
+ * @cmd: The command line to run.
+ * @argv: The arguments that were passed to the shell.
+ * @env: The environment variables array
+ * Description: A single command with nothing to expand is split on
+ * blanks, and exec'ed in place when it is external, so it costs one fork
+ * in total. Anything else is parsed and expanded word by word. Never
+ * returns.
+ **/
+void run_substitution_child(char *cmd, char *argv[], char **env)
+{
+	shell_data data = {NULL, HISTORY_OFF, 0, 0};
+	char *args[MAX_CMD_LEN / 2];
+	int i = 0;
+
+	if (strpbrk(cmd, ";`$'\"\\") == NULL)
+	{
+		args[i] = strtok(cmd, " \t\n");
+		while (args[i] != NULL && i < MAX_CMD_LEN / 2 - 1)
+			args[++i] = strtok(NULL, " \t\n");
+		args[i] = NULL;
+		if (args[0] == NULL)
+			_exit(EXIT_SUCCESS);
+		if (!is_builtin(args[0]) && def_lookup(args[0], 0) == NULL)
+			handle_child_process(args, argv, -1, env);
+		execute_cmd(args, argv, &data, env);
+	}
+	else
+		run_command_line(cmd, argv, &data, env);
+	fflush(stdout);
+	_exit(get_last_status());
+}
+
+/**
+ * capture_external_output - Runs commands in a child and captures stdout.
+ * @cmd: The command line to run.
+ * @argv: The arguments that were passed to the shell.
+ * @env: The environment variables array
+ * Return: The malloc'ed output, or NULL on failure.
+ * Description: The output is read through a pipe into a growable buffer
+ * while the child runs; the child's exit status becomes the shell's.
+ **/
+char *capture_external_output(char *cmd, char *argv[], char **env)
+{
+	int fds[2], status;
+	char *out;
+	pid_t pid;
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (NULL);
+	fflush(stdout);
+	pid = fork();
+	if (pid < 0)
+		handle_fork_error();
+	if (pid == 0)
+	{
+		dup2(fds[1], STDOUT_FILENO);
+		run_substitution_child(cmd, argv, env);
+	}
+	close(fds[1]);
+	out = read_fd_all(fds[0]);
+	close(fds[0]);
+	if (waitpid(pid, &status, 0) != -1)
+		set_last_status(status_from_wait(status));
+	return (out);
+}
+
+/**
+ * capture_output - Runs the body of a command substitution.
+ * @inner: Start of the inner command text.
+ * @n: Length of the inner command text.
+ * @argv: The arguments that were passed to the shell.
+ * @env: The environment variables array
+ * Return: The malloc'ed output of the commands, or NULL on failure.
+ * Description: Builtins that only print run in-process; anything else,
+ * functions included, runs in a child process so it cannot change the
+ * shell. Variables and nested substitutions are expanded word by word
+ * when the inner commands run.
+ **/
+char *capture_output(char *inner, size_t n, char *argv[], char **env)
+{
+	char *cmd, *out;
+
+	cmd = strndup(inner, n);
+	if (cmd == NULL)
+		return (NULL);
+	if (substitution_in_process(cmd))
+		out = capture_builtin_output(cmd, argv, env);
+	else
+		out = capture_external_output(cmd, argv, env);
+	free(cmd);
+	return (out);
+}
@@ -0,0 +1,132 @@
+#include "shell.h"
+
+/**
+ * cf_new_node - Allocates a zeroed control flow node.
+ * @p: The parser state, marked as failed if memory runs out.
+ * @type: The node type.
+ * Return: The new node, or NULL on allocation failure.
+ **/
+cf_node *cf_new_node(cf_parser *p, int type)
+{
+	cf_node *node = calloc(1, sizeof(cf_node));
+
+	if (node == NULL)
+	{
+		p->status = CF_ERROR;
+		return (NULL);
+	}
+	node->type = type;
+	return (node);
+}
+
+/**
+ * cf_copy_words - Copies the word tokens of a range into a new array.
+ * @p: The parser state, marked as failed if memory runs out.
+ * @start: Index of the first token.
+ * @end: Index one past the last token.
+ * Return: A malloc'ed NULL-terminated array of malloc'ed words.
+ **/
+char **cf_copy_words(cf_parser *p, int start, int end)
+{
+	char **words = calloc(end - start + 1, sizeof(char *));
+	int i, n = 0;
+
+	if (words == NULL)
+	{
+		p->status = CF_ERROR;
+		return (NULL);
+	}
+	for (i = start; i < end; i++)
+	{
+		if (p->toks[i].type != TOK_WORD)
+			continue;
+		words[n] = strdup(p->toks[i].text);
+		if (words[n++] == NULL)
+			p->status = CF_ERROR;
+	}
+	return (words);
+}
+
+/**
+ * cf_free_tree - Frees a list of control flow nodes and their children.
+ * @node: The first node of the list.
+ **/
+void cf_free_tree(cf_node *node)
+{
+	cf_node *next;
+	int i;
+
+	while (node != NULL)
+	{
+		next = node->next;
+		for (i = 0; node->words != NULL && node->words[i] != NULL; i++)
+			free(node->words[i]);
+		free(node->words);
+		free(node->name);
+		free(node->here);
+		cf_free_tree(node->cond);
+		cf_free_tree(node->body);
+		cf_free_tree(node->alt);
+		free(node);
+		node = next;
+	}
+}
+
+/**
+ * cf_parse - Parses the text of a control block into a tree.
+ * @text: The block text, possibly spanning several lines.
+ * @status: Set to CF_OK, CF_INCOMPLETE (more lines needed) or CF_ERROR.
+ * Return: The parsed command list when @status is CF_OK, NULL otherwise.
+ **/
+cf_node *cf_parse(char *text, int *status)
+{
+	cf_parser p;
+	cf_node *tree;
+
+	p.toks = cf_lex(text);
+	p.pos = 0;
+	p.status = CF_OK;
+	if (p.toks == NULL)
+	{
+		*status = CF_ERROR;
+		return (NULL);
+	}
+	tree = cf_parse_list(&p, NULL);
+	if (p.status == CF_OK && p.toks[p.pos].type != TOK_EOF)
+		p.status = CF_ERROR;
+	cf_free_tokens(p.toks, -1);
+	*status = p.status;
+	if (p.status != CF_OK)
+	{
+		cf_free_tree(tree);
+		return (NULL);
+	}
+	return (tree);
+}
+
+/**
+ * is_control_start - Checks whether a line opens a control block.
+ * @line: The command line.
+ * Return: 1 if the first word is if, while, until, for, case or function,
+ * or the line starts a "NAME()" function definition.
+ **/
+int is_control_start(const char *line)
+{
+	const char *openers[] = {"if", "while", "until", "for", "case",
+		"function", NULL};
+	size_t len;
+	int i;
+
+	while (*line == ' ' || *line == '\t')
+		line++;
+	len = strcspn(line, " \t;(");
+	if (len > 0 && strncmp(line + len + strspn(line + len, " \t"), "()", 2)
+			== 0)
+		return (1);
+	for (i = 0; openers[i] != NULL; i++)
+	{
+		if (strlen(openers[i]) == len && strncmp(line, openers[i], len) == 0)
+			return (1);
+	}
+	return (0);
+}
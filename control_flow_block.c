@@ -0,0 +1,152 @@
+#include "shell.h"
+
+/**
+ * cf_word_in - Checks whether a word is in a list of words.
+ * @word: The word to look for.
+ * @list: NULL-terminated list of words.
+ * Return: 1 if @word is in @list, 0 otherwise.
+ **/
+int cf_word_in(const char *word, const char *const *list)
+{
+	int i;
+
+	for (i = 0; list[i] != NULL; i++)
+	{
+		if (strcmp(word, list[i]) == 0)
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * cf_line_depth - Counts the blocks a line opens and closes.
+ * @line: One line of a control block.
+ * Return: The number of if/while/until/for/case/{ keywords minus the
+ * number of fi/done/esac/} keywords on the line.
+ * Description: Keywords only count in command position, so that
+ * "echo if" opens nothing. The word after "for" or "case" is not a
+ * command, and neither is the name of a function.
+ **/
+int cf_line_depth(char *line)
+{
+	const char *const open[] = {"if", "while", "until", "for", "case", "{",
+		NULL};
+	const char *const close[] = {"fi", "done", "esac", "}", NULL};
+	const char *const keep[] = {"if", "while", "until", "{", "then", "do",
+		"else", "elif", "!", NULL};
+	cf_token *toks = cf_lex(line);
+	int i, depth = 0, cmd = 1;
+
+	for (i = 0; toks != NULL && toks[i].type != TOK_EOF; i++)
+	{
+		if (toks[i].type >= TOK_HEREDOC)
+			continue;
+		if (toks[i].type != TOK_WORD || cmd == -1)
+		{
+			cmd = 1;
+			continue;
+		}
+		if (!cmd)
+			continue;
+		if (cf_word_in(toks[i].text, open))
+			depth++;
+		else if (cf_word_in(toks[i].text, close))
+			depth--;
+		cmd = cf_word_in(toks[i].text, keep) ? 1 :
+			(strcmp(toks[i].text, "function") == 0 ? -1 : 0);
+	}
+	cf_free_tokens(toks, -1);
+	return (depth);
+}
+
+/**
+ * cf_block_add_line - Adds a line to the text of a control block.
+ * @line: The line.
+ * @fd: The stream the line came from; the bodies of here-documents the
+ * line opens are read from it and added to the text as they are.
+ * @text: Pointer to the block text.
+ * @len: Pointer to the length of the text.
+ * @cap: Pointer to the allocated size of the text.
+ * Return: The number of blocks the line opens minus those it closes;
+ * keywords inside here-document bodies don't count.
+ **/
+int cf_block_add_line(char *line, FILE *fd, char **text, size_t *len,
+		size_t *cap)
+{
+	char *op, *delim, *body;
+	size_t n;
+	int strip;
+
+	if (*len > 0)
+		buf_append(text, len, cap, "\n", 1);
+	buf_append(text, len, cap, line, strlen(line));
+	for (op = heredoc_find(line); op != NULL; op = heredoc_find(op))
+	{
+		strip = (op[2] == '-');
+		delim = (op[2] != '<') ? heredoc_word(op + 2 + strip, &op) : NULL;
+		if (delim == NULL)
+		{
+			op += 2;
+			continue;
+		}
+		body = heredoc_read_body(fd, delim, strip, &n);
+		buf_append(text, len, cap, "\n", 1);
+		if (body != NULL)
+			buf_append(text, len, cap, body, n);
+		buf_append(text, len, cap, delim, strlen(delim));
+		free(body);
+		free(delim);
+	}
+	return (cf_line_depth(line));
+}
+
+/**
+ * run_control_block - Parses and runs an if/while/until/for/case block.
+ * @line: The line that opens the block.
+ * @fd: The stream the line came from; further lines are read from it
+ * until the block is complete.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Description: Lines are collected until every block keyword is closed,
+ * and only then is the text parsed into a tree, which is run in-process;
+ * loop bodies are never re-read or re-tokenized.
+ **/
+void run_control_block(char *line, FILE *fd, char *argv[],
+		shell_data *data, char **env)
+{
+	char next[MAX_CMD_LEN];
+	char *text = NULL;
+	size_t len = 0, cap = 0;
+	cf_node *tree = NULL;
+	int status = CF_INCOMPLETE, depth, eof = 0;
+
+	depth = cf_block_add_line(line, fd, &text, &len, &cap);
+	while (1)
+	{
+		if (depth <= 0 || eof)
+		{
+			tree = cf_parse(text, &status);
+			if (status != CF_INCOMPLETE || eof)
+				break;
+		}
+		eof = fgets(next, MAX_CMD_LEN, fd) == NULL;
+		if (eof)
+			continue;
+		next[strcspn(next, "\n")] = '\0';
+		handle_comments(next);
+		depth += cf_block_add_line(next, fd, &text, &len, &cap);
+	}
+	free(text);
+	if (status != CF_OK)
+	{
+		write(STDERR_FILENO, status == CF_INCOMPLETE ?
+				"syntax error: unexpected end of file\n" :
+				"syntax error: unexpected token\n",
+				status == CF_INCOMPLETE ? 37 : 31);
+		set_last_status(2);
+		return;
+	}
+	cf_exec_list(tree, argv, data, env);
+	cf_free_tree(tree);
+}
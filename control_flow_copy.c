@@ -0,0 +1,89 @@
+#include "shell.h"
+
+/**
+ * cf_copy_strings - Copies a NULL-terminated array of strings.
+ * @words: The array to copy, or NULL.
+ * @failed: Set to 1 if memory runs out.
+ * Return: A malloc'ed copy of @words, or NULL if @words is NULL.
+ **/
+char **cf_copy_strings(char **words, int *failed)
+{
+	char **copy;
+	int i, n = 0;
+
+	if (words == NULL)
+		return (NULL);
+	while (words[n] != NULL)
+		n++;
+	copy = calloc(n + 1, sizeof(char *));
+	if (copy == NULL)
+	{
+		*failed = 1;
+		return (NULL);
+	}
+	for (i = 0; i < n; i++)
+	{
+		copy[i] = strdup(words[i]);
+		if (copy[i] == NULL)
+			*failed = 1;
+	}
+	return (copy);
+}
+
+/**
+ * cf_copy_node - Copies one control flow node and its children.
+ * @node: The node to copy; its next pointer is not followed.
+ * @failed: Set to 1 if memory runs out.
+ * Return: The copy, or NULL on allocation failure.
+ **/
+cf_node *cf_copy_node(cf_node *node, int *failed)
+{
+	cf_node *copy = calloc(1, sizeof(cf_node));
+
+	if (copy == NULL)
+	{
+		*failed = 1;
+		return (NULL);
+	}
+	copy->type = node->type;
+	copy->here_type = node->here_type;
+	copy->words = cf_copy_strings(node->words, failed);
+	if (node->name != NULL && (copy->name = strdup(node->name)) == NULL)
+		*failed = 1;
+	if (node->here != NULL && (copy->here = strdup(node->here)) == NULL)
+		*failed = 1;
+	copy->cond = cf_copy_tree(node->cond);
+	copy->body = cf_copy_tree(node->body);
+	copy->alt = cf_copy_tree(node->alt);
+	if ((node->cond != NULL && copy->cond == NULL) ||
+			(node->body != NULL && copy->body == NULL) ||
+			(node->alt != NULL && copy->alt == NULL))
+		*failed = 1;
+	return (copy);
+}
+
+/**
+ * cf_copy_tree - Copies a list of control flow nodes and their children.
+ * @node: The first node of the list, or NULL.
+ * Return: The copied list, or NULL if @node is NULL or memory runs out.
+ * Description: Used where a parsed tree must outlive the node holding it,
+ * such as a function definition that may run again inside a loop.
+ **/
+cf_node *cf_copy_tree(cf_node *node)
+{
+	cf_node *head = NULL, **tail = &head;
+	int failed = 0;
+
+	for (; node != NULL && !failed; node = node->next)
+	{
+		*tail = cf_copy_node(node, &failed);
+		if (*tail != NULL)
+			tail = &(*tail)->next;
+	}
+	if (failed)
+	{
+		cf_free_tree(head);
+		return (NULL);
+	}
+	return (head);
+}
@@ -0,0 +1,141 @@
+#include "shell.h"
+
+/**
+ * cf_exec_list - Runs a list of control flow nodes in order.
+ * @node: The first node of the list.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the last node run, or of the last command
+ * run before the list if it is empty.
+ * Description: Stops early when a command fails under set -e, and on
+ * exit, break, continue or return (see set_jump).
+ **/
+int cf_exec_list(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	int status = get_last_status();
+
+	for (; node != NULL && !jump_pending(); node = node->next)
+		status = cf_exec_node(node, argv, data, env);
+	return (status);
+}
+
+/**
+ * cf_exec_simple - Runs a simple command node.
+ * @node: The CF_SIMPLE node.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the command.
+ * Description: The words were split when the block was parsed; only the
+ * ones containing '$', backticks or quotes are expanded here. A
+ * here-document or here-string is fed to stdin while the command runs.
+ * The argument arrays live on the heap, so that nested function calls
+ * only use a little stack each.
+ **/
+int cf_exec_simple(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	char **args = malloc(sizeof(char *) * CF_MAX_ARGS * 2), **bufs;
+	int i, saved = -1;
+
+	if (args == NULL)
+	{
+		write(STDERR_FILENO, "Failed to allocate memory\n", 26);
+		set_last_status(EXIT_FAILURE);
+		return (EXIT_FAILURE);
+	}
+	bufs = args + CF_MAX_ARGS;
+	cf_expand_args(node->words, args, bufs, CF_MAX_ARGS, argv);
+	if (node->here != NULL)
+		saved = cf_here_stdin(node, argv);
+	if (args[0] != NULL && (node->here == NULL || saved != -1))
+		execute_cmd(args, argv, data, env);
+	else if (node->here != NULL && saved == -1)
+		set_last_status(EXIT_FAILURE);
+	if (saved != -1)
+		stdin_restore(saved);
+	for (i = 0; bufs[i] != NULL; i++)
+		free(bufs[i]);
+	free(args);
+	return (get_last_status());
+}
+
+/**
+ * cf_exec_case - Runs the first case arm whose pattern matches.
+ * @node: The CF_CASE node.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the arm that ran, 0 if none matched.
+ **/
+int cf_exec_case(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	char *subject, *pattern, *pat, *save;
+	cf_node *arm;
+	int i, found = 0, status = EXIT_SUCCESS;
+
+	subject = cf_expand_word(node->words[0], argv, CF_EXPAND_QUOTES);
+	for (arm = node->alt; arm != NULL && subject != NULL && !found;
+			arm = arm->next)
+	{
+		for (i = 0; arm->words[i] != NULL && !found; i++)
+		{
+			pattern = cf_expand_word(arm->words[i], argv,
+					CF_EXPAND_QUOTES);
+			for (pat = strtok_r(pattern, "|", &save); pat != NULL && !found;
+					pat = strtok_r(NULL, "|", &save))
+				found = fnmatch(pat, subject, 0) == 0;
+			free(pattern);
+		}
+		if (found)
+			status = cf_exec_list(arm->body, argv, data, env);
+	}
+	free(subject);
+	return (status);
+}
+
+/**
+ * cf_exec_node - Runs a single control flow node.
+ * @node: The node to run.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the node, which is also recorded as the
+ * shell's last exit status and checked against set -e.
+ * Description: A function definition gives the function table its own
+ * copy of the body, so the definition can run again, e.g. in a loop.
+ **/
+int cf_exec_node(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	cf_node *body;
+	int status = EXIT_SUCCESS;
+
+	if (node->type == CF_SIMPLE)
+		status = cf_exec_simple(node, argv, data, env);
+	else if (node->type == CF_IF || node->type == CF_ELIF)
+	{
+		if (cf_exec_cond(node->cond, argv, data, env) == 0)
+			status = cf_exec_list(node->body, argv, data, env);
+		else if (node->alt != NULL && node->alt->type == CF_ELIF)
+			status = cf_exec_node(node->alt, argv, data, env);
+		else if (node->alt != NULL)
+			status = cf_exec_list(node->alt, argv, data, env);
+	}
+	else if (node->type == CF_WHILE || node->type == CF_UNTIL)
+		status = cf_exec_while(node, argv, data, env);
+	else if (node->type == CF_FOR)
+		status = cf_exec_for(node, argv, data, env);
+	else if (node->type == CF_CASE)
+		status = cf_exec_case(node, argv, data, env);
+	else if (node->type == CF_FUNCDEF)
+	{
+		body = cf_copy_tree(node->body);
+		if (body != NULL)
+			define_function(node->name, body);
+		else
+			status = EXIT_FAILURE;
+	}
+	set_last_status(status);
+	errexit_check(status);
+	return (status);
+}
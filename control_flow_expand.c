@@ -0,0 +1,227 @@
+#include "shell.h"
+
+/**
+ * cf_expand_special - Appends the value of a special parameter to a buffer.
+ * @s: Pointer just past the '$'.
+ * @buf: Pointer to the buffer.
+ * @len: Pointer to the number of bytes used.
+ * @cap: Pointer to the allocated size of the buffer.
+ * @flags: CF_EXPAND_* flags; with CF_EXPAND_SPLIT the parameters of $@
+ * (and of $* outside double quotes) are separated by CF_FIELD_SEP.
+ * Return: Pointer to the first character after the parameter, or NULL if
+ * @s is not one of $?, $#, $0 to $9, $@ or $*.
+ **/
+char *cf_expand_special(char *s, char **buf, size_t *len, size_t *cap,
+		int flags)
+{
+	char num[16];
+	char *value, sep;
+	int n;
+
+	if (*s == '?' || *s == '#')
+	{
+		sprintf(num, "%d", *s == '?' ? get_last_status() : count_positional());
+		buf_append(buf, len, cap, num, strlen(num));
+		return (s + 1);
+	}
+	if (*s >= '0' && *s <= '9')
+	{
+		value = get_positional(*s - '0');
+		if (value != NULL)
+			buf_append(buf, len, cap, value, strlen(value));
+		return (s + 1);
+	}
+	if (*s == '@' || *s == '*')
+	{
+		sep = ((flags & CF_EXPAND_SPLIT) &&
+				(*s == '@' || !(flags & CF_EXPAND_QUOTED))) ? CF_FIELD_SEP : ' ';
+		for (n = 1; (value = get_positional(n)) != NULL; n++)
+		{
+			if (n > 1)
+				buf_append(buf, len, cap, &sep, 1);
+			buf_append(buf, len, cap, value, strlen(value));
+		}
+		return (s + 1);
+	}
+	return (NULL);
+}
+
+/**
+ * cf_expand_var - Appends the value of the variable at @s to a buffer.
+ * @s: Pointer just past the '$'.
+ * @buf: Pointer to the buffer.
+ * @len: Pointer to the number of bytes used.
+ * @cap: Pointer to the allocated size of the buffer.
+ * @flags: CF_EXPAND_* flags, passed on to cf_expand_special.
+ * Return: Pointer to the first character after the variable reference.
+ * Description: Handles $NAME, ${NAME} and the special parameters; unset
+ * variables expand to nothing. A lone '$' is copied as is.
+ **/
+char *cf_expand_var(char *s, char **buf, size_t *len, size_t *cap, int flags)
+{
+	char name[256];
+	char *value, *end;
+	size_t n = 0;
+	int braced = (*s == '{');
+
+	end = cf_expand_special(s, buf, len, cap, flags);
+	if (end != NULL)
+		return (end);
+	s += braced;
+	while ((s[n] == '_' || (s[n] >= 'a' && s[n] <= 'z') ||
+				(s[n] >= 'A' && s[n] <= 'Z') ||
+				(n > 0 && s[n] >= '0' && s[n] <= '9')) && n < sizeof(name) - 1)
+	{
+		name[n] = s[n];
+		n++;
+	}
+	name[n] = '\0';
+	if (n == 0)
+	{
+		buf_append(buf, len, cap, braced ? "${" : "$", 1 + braced);
+		return (s);
+	}
+	value = getenv(name);
+	if (value != NULL)
+		buf_append(buf, len, cap, value, strlen(value));
+	return (s + n + (braced && s[n] == '}'));
+}
+
+/**
+ * cf_expand_subst - Runs the command substitution at @p, if there is one.
+ * @p: Pointer to the current position, advanced past the substitution.
+ * @out: Set to the malloc'ed output, or NULL if it could not be captured.
+ * @argv: The arguments that were passed to the shell.
+ * Return: 1 if there was a substitution at @p, 0 otherwise.
+ * Description: Inside backticks, a backslash before '$', '`' or another
+ * backslash is removed before the command runs, so nested backticks can
+ * be written as \`...\`.
+ **/
+int cf_expand_subst(char **p, char **out, char *argv[])
+{
+	char *start = *p, *end, *cmd;
+	size_t i, n = 0;
+
+	if (*start != '`' && (*start != '$' || start[1] != '('))
+		return (0);
+	start += (*start == '$') ? 2 : 1;
+	end = substitution_end(start, **p == '$' ? '(' : '`');
+	if (end == NULL)
+		return (0);
+	cmd = (**p == '`') ? malloc(end - start + 1) : NULL;
+	for (i = 0; cmd != NULL && start + i < end; i++)
+	{
+		if (start[i] == '\\' && start + i + 1 < end &&
+				strchr("$`\\", start[i + 1]) != NULL)
+			i++;
+		cmd[n++] = start[i];
+	}
+	if (cmd != NULL)
+		*out = capture_output(cmd, n, argv, environ);
+	else
+		*out = capture_output(start, end - start, argv, environ);
+	free(cmd);
+	*p = end + 1;
+	return (1);
+}
+
+/**
+ * cf_expand_word - Expands variables and substitutions in a word.
+ * @word: The word as written in the block.
+ * @argv: The arguments that were passed to the shell.
+ * @flags: CF_EXPAND_QUOTES to remove quotes and leave single-quoted text
+ * alone, CF_EXPAND_SPLIT to mark where the word splits into arguments.
+ * Return: The malloc'ed expansion, or NULL on failure.
+ * Description: Substitutions are only taken from the word as written;
+ * the text they produce and the values of variables are added as plain
+ * text and never expanded again. Split points are marked with
+ * CF_FIELD_SEP, and only outside double quotes. A backslash makes the
+ * next character literal (see cf_is_escape) and is removed.
+ **/
+char *cf_expand_word(char *word, char *argv[], int flags)
+{
+	char *buf = NULL, *p = word, *end, *out;
+	size_t len = 0, cap = 0;
+	int err = buf_append(&buf, &len, &cap, "", 0);
+
+	while (!err && *p != '\0')
+	{
+		end = ((flags & CF_EXPAND_QUOTES) && (*p == '\'' || *p == '"')) ?
+			cf_quote_end(p) : NULL;
+		if (cf_is_escape(p, flags))
+		{
+			err = buf_append(&buf, &len, &cap, p + 1, 1);
+			p += 2;
+		}
+		else if (*p == '\'' && end != NULL && !(flags & CF_EXPAND_QUOTED))
+		{
+			err = buf_append(&buf, &len, &cap, p + 1, end - p - 1);
+			p = end + 1;
+		}
+		else if (*p == '"' && (end != NULL || (flags & CF_EXPAND_QUOTED)))
+			flags ^= CF_EXPAND_QUOTED, p++;
+		else if (cf_expand_subst(&p, &out, argv))
+		{
+			err = out == NULL || append_split_output(&buf, &len, &cap, out,
+					(flags & CF_EXPAND_SPLIT) && !(flags & CF_EXPAND_QUOTED) ?
+					CF_FIELD_SEP : '\0');
+			free(out);
+		}
+		else if (*p == '$')
+			p = cf_expand_var(p + 1, &buf, &len, &cap, flags);
+		else
+			err = buf_append(&buf, &len, &cap, p++, 1);
+	}
+	if (err)
+	{
+		free(buf);
+		return (NULL);
+	}
+	return (buf);
+}
+
+/**
+ * cf_expand_args - Expands the words of a command into arguments.
+ * @words: NULL-terminated array of words as written.
+ * @out: Filled with a NULL-terminated argument array.
+ * @bufs: Filled with a NULL-terminated array of buffers to free once the
+ * arguments are no longer needed.
+ * @max: Size of @out and @bufs.
+ * @argv: The arguments that were passed to the shell.
+ * Return: The number of arguments.
+ * Description: Words without '$', backticks, quotes or backslashes are
+ * used as they are. Unquoted substitution output and the parameters of $@
+ * and $* are split into separate arguments, and an unquoted word that
+ * expands to nothing is dropped.
+ **/
+int cf_expand_args(char **words, char **out, char **bufs, int max,
+		char *argv[])
+{
+	char *e, *w, *save, sep[2] = {CF_FIELD_SEP, '\0'};
+	int i, n = 0, nb = 0;
+
+	for (i = 0; words[i] != NULL && n < max - 1; i++)
+	{
+		if (strpbrk(words[i], "$`'\"\\") == NULL)
+		{
+			out[n++] = words[i];
+			continue;
+		}
+		e = cf_expand_word(words[i], argv, CF_EXPAND_QUOTES | CF_EXPAND_SPLIT);
+		if (e == NULL)
+			continue;
+		bufs[nb++] = e;
+		if (strchr(e, CF_FIELD_SEP) == NULL)
+		{
+			if (*e != '\0' || strpbrk(words[i], "'\"") != NULL)
+				out[n++] = e;
+			continue;
+		}
+		for (w = strtok_r(e, sep, &save); w != NULL && n < max - 1;
+				w = strtok_r(NULL, sep, &save))
+			out[n++] = w;
+	}
+	out[n] = NULL;
+	bufs[nb] = NULL;
+	return (n);
+}
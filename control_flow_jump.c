@@ -0,0 +1,74 @@
+#include "shell.h"
+
+static int jump_type;
+static int jump_count;
+static int loop_depth;
+
+/**
+ * set_jump - Asks the running commands to unwind.
+ * @type: JUMP_BREAK, JUMP_CONTINUE, JUMP_RETURN or JUMP_EXIT.
+ * @count: For break and continue, the number of loops to leave.
+ * Description: cf_exec_list stops at once and the loops, functions and
+ * readers above it stop in turn, until the one the jump is meant for
+ * clears it. break and continue outside a loop do nothing, and a count
+ * larger than the number of enclosing loops leaves all of them.
+ **/
+void set_jump(int type, int count)
+{
+	if ((type == JUMP_BREAK || type == JUMP_CONTINUE) && loop_depth == 0)
+		return;
+	jump_type = type;
+	jump_count = (count > loop_depth) ? loop_depth : count;
+}
+
+/**
+ * jump_pending - Checks whether the running commands must unwind.
+ * Return: The pending JUMP_* type, JUMP_NONE if there is none.
+ **/
+int jump_pending(void)
+{
+	return (jump_type);
+}
+
+/**
+ * clear_jump - Ends a pending jump of a given type.
+ * @type: The JUMP_* type the caller handles.
+ * Return: 1 if a jump of @type was pending, 0 otherwise.
+ **/
+int clear_jump(int type)
+{
+	if (jump_type != type)
+		return (0);
+	jump_type = JUMP_NONE;
+	return (1);
+}
+
+/**
+ * loop_jump - Handles a pending jump after a loop body has run.
+ * Return: 1 if the loop must stop, 0 if it goes on.
+ * Description: break and continue count down one loop at a time; the
+ * innermost loop they reach ends the jump, and stops for break. Any
+ * other pending jump stops the loop.
+ **/
+int loop_jump(void)
+{
+	int type = jump_type;
+
+	if (type != JUMP_BREAK && type != JUMP_CONTINUE)
+		return (type != JUMP_NONE);
+	if (--jump_count > 0)
+		return (1);
+	jump_type = JUMP_NONE;
+	return (type == JUMP_BREAK);
+}
+
+/**
+ * loop_nesting - Tracks the loops that break and continue can leave.
+ * @delta: 1 when a loop starts, -1 when it ends, or any other change.
+ * Return: The number of enclosing loops after the change.
+ **/
+int loop_nesting(int delta)
+{
+	loop_depth += delta;
+	return (loop_depth);
+}
@@ -0,0 +1,184 @@
+#include "shell.h"
+
+/**
+ * cf_lex_word - Reads one word of a control block.
+ * @s: Pointer to the current position, advanced past the word.
+ * Return: The malloc'ed word, or NULL on allocation failure.
+ * Description: Quotes group text into the word and are kept, so that
+ * expansion can tell quoted text apart, as are backslashes with the
+ * character they escape; $(...) and backtick
+ * substitutions are kept verbatim so that they run each time the word
+ * is expanded.
+ **/
+char *cf_lex_word(char **s)
+{
+	char *p = *s, *end, *buf = NULL;
+	size_t len = 0, cap = 0;
+	int err = buf_append(&buf, &len, &cap, "", 0);
+
+	while (*p != '\0' && !err && strchr(" \t\n;)", *p) == NULL &&
+			(p[0] != '<' || p[1] != '<'))
+	{
+		end = NULL;
+		if (*p == '\'' || *p == '"')
+			end = cf_quote_end(p);
+		if (end != NULL)
+			err = buf_append(&buf, &len, &cap, p, end - p + 1);
+		else if (*p == '\\' && p[1] != '\0')
+			err = buf_append(&buf, &len, &cap, p, 2), end = p + 1;
+		else if (*p == '`' || (*p == '$' && p[1] == '('))
+		{
+			end = substitution_end(p + (*p == '$' ? 2 : 1),
+					*p == '$' ? '(' : '`');
+			if (end == NULL)
+				end = p + strlen(p) - 1;
+			err = buf_append(&buf, &len, &cap, p, end - p + 1);
+		}
+		else
+			err = buf_append(&buf, &len, &cap, p, 1);
+		p = (end != NULL) ? end + 1 : p + 1;
+	}
+	*s = p;
+	if (err)
+	{
+		free(buf);
+		return (NULL);
+	}
+	return (buf);
+}
+
+/**
+ * cf_add_token - Appends a token to a growable token array.
+ * @toks: Pointer to the token array.
+ * @count: Pointer to the number of tokens in the array.
+ * @type: The token type.
+ * @text: The token text (owned by the array), or NULL.
+ * Return: 0 on success, -1 if memory could not be allocated.
+ **/
+int cf_add_token(cf_token **toks, int *count, int type, char *text)
+{
+	cf_token *tmp;
+
+	if (*count == 0 || (*count >= 16 && (*count & (*count - 1)) == 0))
+	{
+		tmp = realloc(*toks, sizeof(cf_token) * (*count ? *count * 2 : 16));
+		if (tmp == NULL)
+		{
+			free(text);
+			return (-1);
+		}
+		*toks = tmp;
+	}
+	(*toks)[*count].type = type;
+	(*toks)[*count].text = text;
+	(*count)++;
+	return (0);
+}
+
+/**
+ * cf_lex - Splits the text of a control block into tokens.
+ * @s: The text to split.
+ * Return: A malloc'ed token array terminated by a TOK_EOF token, or NULL
+ * on allocation failure.
+ * Description: Newlines and ';' become TOK_SEP, ";;" becomes TOK_DSEMI
+ * and ')' (ending a case pattern) becomes TOK_RPAREN. The bodies of
+ * here-documents opened on a line are skipped at the end of that line.
+ **/
+cf_token *cf_lex(char *s)
+{
+	cf_token *toks = NULL;
+	char *resume = NULL;
+	int count = 0, err = 0;
+
+	while (*s != '\0' && !err)
+	{
+		if (*s == '\n' || (*s == ';' && s[1] != ';'))
+		{
+			err = cf_add_token(&toks, &count, TOK_SEP, NULL);
+			if (*s == '\n' && resume != NULL)
+				s = resume - 1, resume = NULL;
+		}
+		else if (s[0] == '<' && s[1] == '<')
+		{
+			err = cf_lex_redirect(&s, &resume, &toks, &count);
+			continue;
+		}
+		else if (*s == ';')
+			err = cf_add_token(&toks, &count, TOK_DSEMI, NULL), s++;
+		else if (*s == ')')
+			err = cf_add_token(&toks, &count, TOK_RPAREN, NULL);
+		else if (*s != ' ' && *s != '\t')
+		{
+			err = cf_add_token(&toks, &count, TOK_WORD, cf_lex_word(&s));
+			if (!err && toks[count - 1].text == NULL)
+				err = -1;
+			continue;
+		}
+		s++;
+	}
+	if (!err)
+		err = cf_add_token(&toks, &count, TOK_EOF, NULL);
+	if (err)
+	{
+		write(STDERR_FILENO, "Failed to allocate memory\n", 26);
+		cf_free_tokens(toks, count);
+		return (NULL);
+	}
+	return (toks);
+}
+
+/**
+ * cf_lex_redirect - Reads a here-document or here-string operator.
+ * @s: Pointer to the "<<" operator, advanced past the redirection.
+ * @resume: Where lexing goes on after the current line; set past the
+ * body of a here-document, which starts on the next line.
+ * @toks: Pointer to the token array.
+ * @count: Pointer to the number of tokens in the array.
+ * Return: 0 on success, -1 if memory could not be allocated.
+ **/
+int cf_lex_redirect(char **s, char **resume, cf_token **toks, int *count)
+{
+	char *op = *s, *delim, *start;
+	int here_string = (op[2] == '<'), strip = (op[2] == '-'), type;
+
+	*s = op + 2 + (here_string || strip);
+	*s += strspn(*s, " \t");
+	if (here_string)
+	{
+		delim = cf_lex_word(s);
+		if (delim == NULL)
+			return (-1);
+		return (cf_add_token(toks, count, TOK_HERESTRING, delim));
+	}
+	type = (**s == '\'' || **s == '"') ? TOK_HEREDOC_RAW : TOK_HEREDOC;
+	delim = heredoc_word(*s, s);
+	if (delim == NULL)
+		return (-1);
+	start = *resume;
+	if (start == NULL)
+	{
+		start = *s + strcspn(*s, "\n");
+		start += (*start == '\n');
+	}
+	start = heredoc_text_body(start, delim, strip, resume);
+	free(delim);
+	if (start == NULL)
+		return (-1);
+	return (cf_add_token(toks, count, type, start));
+}
+
+/**
+ * cf_free_tokens - Frees a token array.
+ * @toks: The token array.
+ * @count: The number of tokens, or -1 to stop at the TOK_EOF token.
+ **/
+void cf_free_tokens(cf_token *toks, int count)
+{
+	int i;
+
+	if (toks == NULL)
+		return;
+	for (i = 0; count == -1 ? toks[i].type != TOK_EOF : i < count; i++)
+		free(toks[i].text);
+	free(toks);
+}
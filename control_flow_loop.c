@@ -0,0 +1,71 @@
+#include "shell.h"
+
+/**
+ * cf_exec_while - Runs a while or until loop node.
+ * @node: The CF_WHILE or CF_UNTIL node.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the last command of the body, 0 if the
+ * body never ran.
+ * Description: break and continue in the body (or the condition) are
+ * handled by loop_jump; any other jump ends the loop.
+ **/
+int cf_exec_while(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	int status = EXIT_SUCCESS, cond;
+
+	loop_nesting(1);
+	while (1)
+	{
+		cond = cf_exec_cond(node->cond, argv, data, env);
+		if (loop_jump())
+			break;
+		if ((cond == 0) != (node->type == CF_WHILE))
+			break;
+		status = cf_exec_list(node->body, argv, data, env);
+		if (loop_jump())
+			break;
+	}
+	loop_nesting(-1);
+	return (status);
+}
+
+/**
+ * cf_exec_for - Runs a for loop node.
+ * @node: The CF_FOR node.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the last command of the body, 0 if the
+ * body never ran.
+ * Description: The loop variable is exported so that the body (and the
+ * commands it runs) can see it. The items live on the heap like the
+ * arguments of a simple command.
+ **/
+int cf_exec_for(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	char **items = malloc(sizeof(char *) * CF_MAX_ARGS * 2), **bufs;
+	int i, status = EXIT_SUCCESS;
+
+	if (items == NULL)
+	{
+		write(STDERR_FILENO, "Failed to allocate memory\n", 26);
+		return (EXIT_FAILURE);
+	}
+	bufs = items + CF_MAX_ARGS;
+	cf_expand_args(node->words, items, bufs, CF_MAX_ARGS, argv);
+	loop_nesting(1);
+	for (i = 0; items[i] != NULL; i++)
+	{
+		setenv(node->name, items[i], 1);
+		status = cf_exec_list(node->body, argv, data, env);
+		if (loop_jump())
+			break;
+	}
+	loop_nesting(-1);
+	for (i = 0; bufs[i] != NULL; i++)
+		free(bufs[i]);
+	free(items);
+	return (status);
+}
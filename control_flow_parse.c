@@ -0,0 +1,127 @@
+#include "shell.h"
+
+/**
+ * cf_is_word - Checks whether the current token is a given word.
+ * @p: The parser state.
+ * @word: The word to compare against.
+ * Return: 1 if the current token is the word @word, 0 otherwise.
+ **/
+int cf_is_word(cf_parser *p, const char *word)
+{
+	return (p->toks[p->pos].type == TOK_WORD &&
+			strcmp(p->toks[p->pos].text, word) == 0);
+}
+
+/**
+ * cf_expect - Consumes a required keyword, skipping separators first.
+ * @p: The parser state.
+ * @word: The keyword that must come next.
+ * Return: 1 if it was found, 0 otherwise. Running out of input marks the
+ * block as incomplete (more lines are needed); anything else is a
+ * syntax error.
+ **/
+int cf_expect(cf_parser *p, const char *word)
+{
+	while (p->toks[p->pos].type == TOK_SEP)
+		p->pos++;
+	if (p->status != CF_OK)
+		return (0);
+	if (cf_is_word(p, word))
+	{
+		p->pos++;
+		return (1);
+	}
+	p->status = p->toks[p->pos].type == TOK_EOF ? CF_INCOMPLETE : CF_ERROR;
+	return (0);
+}
+
+/**
+ * cf_parse_list - Parses a list of commands.
+ * @p: The parser state.
+ * @stops: NULL-terminated keywords that end the list, or NULL.
+ * Return: The first command of the list, or NULL if it is empty.
+ * Description: The list also ends at end of input, ";;" and ')', which
+ * the caller is responsible for.
+ **/
+cf_node *cf_parse_list(cf_parser *p, const char *const *stops)
+{
+	cf_node *head = NULL, **tail = &head;
+	int i, stop = 0;
+
+	while (p->status == CF_OK && !stop)
+	{
+		while (p->toks[p->pos].type == TOK_SEP)
+			p->pos++;
+		if (p->toks[p->pos].type != TOK_WORD)
+			break;
+		for (i = 0; stops != NULL && stops[i] != NULL && !stop; i++)
+			stop = cf_is_word(p, stops[i]);
+		if (stop)
+			break;
+		*tail = cf_parse_command(p);
+		if (*tail != NULL)
+			tail = &(*tail)->next;
+	}
+	return (head);
+}
+
+/**
+ * cf_parse_simple - Parses a simple command.
+ * @p: The parser state.
+ * Return: The new CF_SIMPLE node, or NULL on failure.
+ * Description: Words are taken up to the next separator; they are stored
+ * already split so running the command never re-tokenizes it. A
+ * here-document or here-string among them is moved to the node.
+ **/
+cf_node *cf_parse_simple(cf_parser *p)
+{
+	cf_node *node = cf_new_node(p, CF_SIMPLE);
+	cf_token *tok;
+	int start = p->pos;
+
+	for (tok = &p->toks[p->pos]; tok->type == TOK_WORD ||
+			tok->type >= TOK_HEREDOC; tok = &p->toks[++p->pos])
+	{
+		if (tok->type == TOK_WORD || node == NULL)
+			continue;
+		free(node->here);
+		node->here = tok->text;
+		node->here_type = tok->type;
+		tok->text = NULL;
+	}
+	if (node != NULL)
+		node->words = cf_copy_words(p, start, p->pos);
+	return (node);
+}
+
+/**
+ * cf_parse_command - Parses one command of a list.
+ * @p: The parser state.
+ * Return: The parsed command node, or NULL on failure.
+ **/
+cf_node *cf_parse_command(cf_parser *p)
+{
+	const char *reserved[] = {"then", "elif", "else", "fi", "do", "done",
+		"esac", "}", NULL};
+	int i;
+
+	if (cf_is_function_start(p))
+		return (cf_parse_function(p));
+	if (cf_is_word(p, "if"))
+		return (cf_parse_if(p));
+	if (cf_is_word(p, "while") || cf_is_word(p, "until"))
+		return (cf_parse_loop(p));
+	if (cf_is_word(p, "for"))
+		return (cf_parse_for(p));
+	if (cf_is_word(p, "case"))
+		return (cf_parse_case(p));
+	for (i = 0; reserved[i] != NULL; i++)
+	{
+		if (cf_is_word(p, reserved[i]))
+		{
+			p->status = CF_ERROR;
+			return (NULL);
+		}
+	}
+	return (cf_parse_simple(p));
+}
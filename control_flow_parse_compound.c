@@ -0,0 +1,167 @@
+#include "shell.h"
+
+/**
+ * cf_parse_if - Parses an if (or elif) clause up to its closing fi.
+ * @p: The parser state, positioned on "if" or "elif".
+ * Return: The new CF_IF node, or NULL on failure.
+ * Description: An elif becomes a CF_ELIF node in @alt which owns the
+ * rest of the chain, including the closing fi.
+ **/
+cf_node *cf_parse_if(cf_parser *p)
+{
+	const char *then_stop[] = {"then", NULL};
+	const char *body_stop[] = {"elif", "else", "fi", NULL};
+	const char *else_stop[] = {"fi", NULL};
+	cf_node *node = cf_new_node(p, cf_is_word(p, "if") ? CF_IF : CF_ELIF);
+
+	p->pos++;
+	if (node == NULL)
+		return (NULL);
+	node->cond = cf_parse_list(p, then_stop);
+	if (!cf_expect(p, "then"))
+		return (node);
+	node->body = cf_parse_list(p, body_stop);
+	if (cf_is_word(p, "elif"))
+		node->alt = cf_parse_if(p);
+	else if (cf_is_word(p, "else"))
+	{
+		p->pos++;
+		node->alt = cf_parse_list(p, else_stop);
+		cf_expect(p, "fi");
+	}
+	else
+		cf_expect(p, "fi");
+	return (node);
+}
+
+/**
+ * cf_parse_loop - Parses a while or until loop.
+ * @p: The parser state, positioned on "while" or "until".
+ * Return: The new CF_WHILE or CF_UNTIL node, or NULL on failure.
+ **/
+cf_node *cf_parse_loop(cf_parser *p)
+{
+	const char *do_stop[] = {"do", NULL};
+	const char *done_stop[] = {"done", NULL};
+	cf_node *node = cf_new_node(p, cf_is_word(p, "while") ?
+			CF_WHILE : CF_UNTIL);
+
+	p->pos++;
+	if (node == NULL)
+		return (NULL);
+	node->cond = cf_parse_list(p, do_stop);
+	if (cf_expect(p, "do"))
+	{
+		node->body = cf_parse_list(p, done_stop);
+		cf_expect(p, "done");
+	}
+	return (node);
+}
+
+/**
+ * cf_parse_for - Parses a for loop.
+ * @p: The parser state, positioned on "for".
+ * Return: The new CF_FOR node, or NULL on failure.
+ * Description: @name holds the loop variable and @words the item words,
+ * which are expanded once when the loop starts.
+ **/
+cf_node *cf_parse_for(cf_parser *p)
+{
+	const char *done_stop[] = {"done", NULL};
+	cf_node *node = cf_new_node(p, CF_FOR);
+	int start;
+
+	p->pos++;
+	if (node == NULL)
+		return (NULL);
+	if (p->toks[p->pos].type != TOK_WORD)
+	{
+		p->status = p->toks[p->pos].type == TOK_EOF ?
+			CF_INCOMPLETE : CF_ERROR;
+		return (node);
+	}
+	node->name = strdup(p->toks[p->pos++].text);
+	if (!cf_expect(p, "in"))
+		return (node);
+	start = p->pos;
+	while (p->toks[p->pos].type == TOK_WORD)
+		p->pos++;
+	node->words = cf_copy_words(p, start, p->pos);
+	if (cf_expect(p, "do"))
+	{
+		node->body = cf_parse_list(p, done_stop);
+		cf_expect(p, "done");
+	}
+	return (node);
+}
+
+/**
+ * cf_parse_arm - Parses one "pattern[|pattern]) commands ;;" case arm.
+ * @p: The parser state, positioned on the first pattern.
+ * Return: The new CF_ARM node, or NULL on failure.
+ * Description: Patterns may be written as "a|b" or "a | b"; the words
+ * are stored as written and split on '|' when matched.
+ **/
+cf_node *cf_parse_arm(cf_parser *p)
+{
+	const char *esac_stop[] = {"esac", NULL};
+	cf_node *node = cf_new_node(p, CF_ARM);
+	int start = p->pos;
+
+	while (p->toks[p->pos].type == TOK_WORD)
+		p->pos++;
+	if (node == NULL)
+		return (NULL);
+	node->words = cf_copy_words(p, start, p->pos);
+	if (p->toks[p->pos].type != TOK_RPAREN)
+	{
+		p->status = p->toks[p->pos].type == TOK_EOF ?
+			CF_INCOMPLETE : CF_ERROR;
+		return (node);
+	}
+	p->pos++;
+	node->body = cf_parse_list(p, esac_stop);
+	if (p->toks[p->pos].type == TOK_DSEMI)
+		p->pos++;
+	return (node);
+}
+
+/**
+ * cf_parse_case - Parses a case statement.
+ * @p: The parser state, positioned on "case".
+ * Return: The new CF_CASE node, or NULL on failure.
+ * Description: @words holds the subject word and @alt the list of arms.
+ **/
+cf_node *cf_parse_case(cf_parser *p)
+{
+	cf_node *node = cf_new_node(p, CF_CASE);
+	cf_node **tail;
+
+	p->pos++;
+	if (node == NULL)
+		return (NULL);
+	if (p->toks[p->pos].type != TOK_WORD)
+	{
+		p->status = p->toks[p->pos].type == TOK_EOF ?
+			CF_INCOMPLETE : CF_ERROR;
+		return (node);
+	}
+	node->words = cf_copy_words(p, p->pos, p->pos + 1);
+	p->pos++;
+	tail = &node->alt;
+	if (!cf_expect(p, "in"))
+		return (node);
+	while (p->status == CF_OK)
+	{
+		while (p->toks[p->pos].type == TOK_SEP)
+			p->pos++;
+		if (p->toks[p->pos].type == TOK_EOF)
+			p->status = CF_INCOMPLETE;
+		else if (cf_is_word(p, "esac"))
+			break;
+		else if ((*tail = cf_parse_arm(p)) != NULL)
+			tail = &(*tail)->next;
+	}
+	cf_expect(p, "esac");
+	return (node);
+}
@@ -0,0 +1,59 @@
+#include "shell.h"
+
+/**
+ * cf_is_function_start - Checks whether a function definition starts at
+ * the current token.
+ * @p: The parser state.
+ * Return: 1 for "function NAME", "NAME()" or "NAME ()", 0 otherwise.
+ **/
+int cf_is_function_start(cf_parser *p)
+{
+	cf_token *tok = &p->toks[p->pos];
+	size_t len = strlen(tok->text);
+
+	if (cf_is_word(p, "function"))
+		return (1);
+	if (len > 1 && tok->text[len - 1] == '(' && tok[1].type == TOK_RPAREN)
+		return (1);
+	return (tok[1].type == TOK_WORD && strcmp(tok[1].text, "(") == 0 &&
+			tok[2].type == TOK_RPAREN);
+}
+
+/**
+ * cf_parse_function - Parses a function definition.
+ * @p: The parser state, positioned on the start of the definition.
+ * Return: The new CF_FUNCDEF node, or NULL on failure.
+ * Description: The body is a { ... } list; '{' and '}' must be separate
+ * words, as in other shells.
+ **/
+cf_node *cf_parse_function(cf_parser *p)
+{
+	const char *body_stop[] = {"}", NULL};
+	cf_node *node = cf_new_node(p, CF_FUNCDEF);
+
+	if (node == NULL)
+		return (NULL);
+	if (cf_is_word(p, "function"))
+		p->pos++;
+	if (p->toks[p->pos].type != TOK_WORD)
+	{
+		p->status = p->toks[p->pos].type == TOK_EOF ?
+			CF_INCOMPLETE : CF_ERROR;
+		return (node);
+	}
+	node->name = strndup(p->toks[p->pos].text,
+			strcspn(p->toks[p->pos].text, "("));
+	p->pos++;
+	if (cf_is_word(p, "("))
+		p->pos++;
+	if (p->toks[p->pos].type == TOK_RPAREN)
+		p->pos++;
+	if (node->name == NULL || node->name[0] == '\0')
+		p->status = CF_ERROR;
+	if (cf_expect(p, "{"))
+	{
+		node->body = cf_parse_list(p, body_stop);
+		cf_expect(p, "}");
+	}
+	return (node);
+}
@@ -0,0 +1,51 @@
+#include "shell.h"
+
+/**
+ * cf_quote_end - Finds the quote closing the one at @p.
+ * @p: Pointer to an opening single or double quote.
+ * Return: Pointer to the closing quote, or NULL if there is none.
+ * Description: Inside double quotes a backslash keeps the next character
+ * from closing them, and quotes inside a substitution belong to it;
+ * inside single quotes neither has any special meaning.
+ **/
+char *cf_quote_end(char *p)
+{
+	char quote = *p;
+
+	for (p++; *p != '\0' && *p != quote; p++)
+	{
+		if (quote != '"')
+			continue;
+		if (*p == '\\' && p[1] != '\0')
+			p++;
+		else if (*p == '`' || (*p == '$' && p[1] == '('))
+		{
+			p = substitution_end(p + (*p == '$' ? 2 : 1),
+					*p == '$' ? '(' : '`');
+			if (p == NULL)
+				return (NULL);
+		}
+	}
+	return (*p == quote ? p : NULL);
+}
+
+/**
+ * cf_is_escape - Checks whether a backslash escapes the next character.
+ * @p: Pointer to the current position of the word being expanded.
+ * @flags: The CF_EXPAND_* flags in effect at @p.
+ * Return: 1 if @p is a backslash that makes p[1] literal, 0 otherwise.
+ * Description: Outside quotes a backslash escapes any character. Inside
+ * double quotes, and in here-document bodies (no CF_EXPAND_QUOTES), it
+ * only escapes '$', '`' and '\\', and '"' inside double quotes; before
+ * anything else it is kept as is.
+ **/
+int cf_is_escape(char *p, int flags)
+{
+	if (p[0] != '\\' || p[1] == '\0')
+		return (0);
+	if ((flags & CF_EXPAND_QUOTES) && !(flags & CF_EXPAND_QUOTED))
+		return (1);
+	if ((flags & CF_EXPAND_QUOTED) && p[1] == '"')
+		return (1);
+	return (strchr("$`\\", p[1]) != NULL);
+}
@@ -0,0 +1,88 @@
+#include "shell.h"
+
+static int errexit_enabled;
+static int errexit_condition_depth;
+static int errexit_failed;
+
+/**
+ * errexit_check - Applies the errexit policy to a command's status.
+ * @status: The final exit status of a command that just completed.
+ * Description: With set -e, a failure outside an if, while or until
+ * condition marks the script as failed and makes the shell exit as the
+ * exit builtin does; without it the script goes on.
+ **/
+void errexit_check(int status)
+{
+	if (errexit_enabled && status != 0 && errexit_condition_depth == 0 &&
+			errexit_failed == 0)
+	{
+		errexit_failed = status;
+		set_jump(JUMP_EXIT, 0);
+	}
+}
+
+/**
+ * errexit_tripped - Checks whether the script must stop.
+ * Return: The exit status of the command that failed under set -e, which
+ * the shell exits with, or 0 if none did.
+ **/
+int errexit_tripped(void)
+{
+	return (errexit_failed);
+}
+
+/**
+ * cf_exec_cond - Runs the condition list of an if, elif, while or until.
+ * @node: The first node of the condition list.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: The exit status of the condition.
+ * Description: Failures are expected in conditions, so they never stop
+ * the script under set -e.
+ **/
+int cf_exec_cond(cf_node *node, char *argv[], shell_data *data, char **env)
+{
+	int status;
+
+	errexit_condition_depth++;
+	status = cf_exec_list(node, argv, data, env);
+	errexit_condition_depth--;
+	return (status);
+}
+
+/**
+ * set_errexit - Turns the errexit policy on or off.
+ * @on: Non-zero to stop scripts at the first failing command.
+ **/
+void set_errexit(int on)
+{
+	errexit_enabled = on;
+	errexit_failed = 0;
+}
+
+/**
+ * execute_set - Executes the 'set' command
+ * @args: The arguments for the 'set' command
+ * Description: Supports -e / +e and -o errexit / +o errexit.
+ */
+void execute_set(char **args)
+{
+	int i;
+
+	for (i = 1; args[i] != NULL; i++)
+	{
+		if ((args[i][0] == '-' || args[i][0] == '+') &&
+				strcmp(args[i] + 1, "e") == 0)
+			set_errexit(args[i][0] == '-');
+		else if ((strcmp(args[i], "-o") == 0 || strcmp(args[i], "+o") == 0) &&
+				args[i + 1] != NULL && strcmp(args[i + 1], "errexit") == 0)
+			set_errexit(args[i++][0] == '-');
+		else
+		{
+			fprintf(stderr, "set: %s: invalid option\n", args[i]);
+			set_last_status(2);
+			return;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#include "shell.h"
+
+static int last_exit_status;
+
+/**
+ * set_last_status - Records the exit status of the last command.
+ * @status: The exit status to record.
+ * Description: The status is kept for the lifetime of the shell so that
+ * non-interactive callers (script, -c and daemon modes) can report it.
+ * Intermediate statuses, such as that of a $(...) inside a command, are
+ * recorded here too; only the final status of each command is checked
+ * against the errexit policy (see cf_exec_node).
+ **/
+void set_last_status(int status)
+{
+	last_exit_status = status;
+}
+
+/**
+ * get_last_status - Retrieves the exit status of the last command.
+ * Return: The last recorded exit status, 0 if nothing has run yet.
+ **/
+int get_last_status(void)
+{
+	return (last_exit_status);
+}
+
+/**
+ * status_from_wait - Converts a waitpid status to a shell exit status.
+ * @status: The raw status filled in by waitpid.
+ * Return: The exit code for normal exits, 128 + signal number for
+ * processes killed by a signal.
+ **/
+int status_from_wait(int status)
+{
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	if (WIFSIGNALED(status))
+		return (128 + WTERMSIG(status));
+	return (EXIT_FAILURE);
+}
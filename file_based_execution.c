@@ -9,6 +9,10 @@
  * @argv:   An array of strings containing the command line arguments.
  * @data:   A data structure to manage shell-related information.
  * @env: The environment variables array
+ *
+ * Description: A command failing under set -e ends the shell with that
+ * command's status, and exit with its own; otherwise every file runs to
+ * the end.
  */
 void execute_commands_from_file(int argc, char *argv[],
 		shell_data data, char **env)
@@ -17,6 +21,7 @@ void execute_commands_from_file(int argc, char *argv[],
 	FILE *fd;
 
 	data.head = NULL;
+	data.history_state = HISTORY_OFF;
 	for (i = 1; i < argc; i++)
 	{
 		/* Open the command file */
@@ -35,6 +40,10 @@ void execute_commands_from_file(int argc, char *argv[],
 		}
 		clear_history(&data);
 		free_commands(&data);
+		if (errexit_tripped())
+			exit(errexit_tripped());
+		if (jump_pending() == JUMP_EXIT)
+			exit(get_last_status());
 	}
 }
 
@@ -46,12 +55,17 @@ void execute_commands_from_file(int argc, char *argv[],
  * @data: The shell data structure.
  * @env: The environment variables array
  *
+ * Description: Lines opening an if, while, until, for or case block are
+ * handed to run_control_block together with the rest of the block, and
+ * lines with a here-document to run_with_heredoc together with its body.
+ * Other lines are parsed like a block, so every command of a ';' list is
+ * checked against set -e and reading stops at the first one that fails,
+ * or at exit.
  * Return: void
  */
 void read_and_execute_commands(FILE * fd, char *argv[],
 		shell_data data, char **env)
 {
-	
 	char cmd[MAX_CMD_LEN];
 
 	/* Read commands from the file */
@@ -67,11 +81,23 @@ void read_and_execute_commands(FILE * fd, char *argv[],
 		{
 		    continue;
 		}
-		if (strncmp(cmd, "exit", 4) == 0 || strncmp(cmd, "quit", 4) == 0)
+		if (strncmp(cmd, "quit", 4) == 0 || jump_pending())
 		{
 		    break;
 		}
-		handle_semicolon(cmd, argv, &data, env);
+		if (is_control_start(cmd))
+		{
+			run_control_block(cmd, fd, argv, &data, env);
+			continue;
+		}
+		if (heredoc_find(cmd) != NULL)
+		{
+			run_with_heredoc(cmd, fd, argv, &data, env);
+			continue;
+		}
+		run_command_line(cmd, argv, &data, env);
+		if (jump_pending())
+			break;
 	}
 }
 
@@ -89,51 +115,57 @@ void handle_fork_error(void)
 
 /**
  * handle_child_process - Handles the child process after a
- * fork by executing the command.
+ * fork by applying the ulimit settings and executing the command.
  * @args: The arguments for the command to execute.
  * @argv: The arguments that were passed to the program.
- * @error_message: The error message to print if the
- * command cannot be executed.
- * @length: The length of the error message.
+ * @status_fd: Close-on-exec pipe to report a failed exec on, or -1 to
+ * print the error here instead.
  * @env: The environment variables array
  *
- * Return: void
+ * Return: Does not return: the process either becomes the command or
+ * exits with 127 (not found) or 126 (found but not executable).
  */
 void handle_child_process(char *args[], char *argv[],
-		char *error_message, int length, char **env)
+		int status_fd, char **env)
 {
-	/* Try to execute the command directly */
-	if (execvp(args[0], args) == -1)
+	int err;
+
+	apply_child_limits();
+	err = execute_command_in_path(args, env);
+	if (status_fd != -1)
+	{
+		if (write(status_fd, &err, sizeof(err)) != sizeof(err))
+			report_exec_error(argv, args, err);
+	}
+	else
 	{
-		execute_command_in_path(args, error_message, &length, env);
-		/* If we still can't execute the command, print an error message */
-		print_error_message(argv, args, error_message, length);
-		exit(127);
+		report_exec_error(argv, args, err);
 	}
+	_exit(exec_failure_status(err));
 }
 
 /**
  * handle_parent_process - Handles the parent process after a
- * fork by waiting for the child process to finish.
+ * fork by waiting for the child process to finish and recording
+ * its exit status.
  * @pid: The process ID of the child process.
  *
+ * Description: A failing command never ends the shell here; whether a
+ * script stops is decided by the errexit setting (set -e).
  * Return: void
  */
 void handle_parent_process(pid_t pid)
 {
 	int status;
 
-	if (waitpid(pid, &status, 0) == -1)
+	while (waitpid(pid, &status, 0) == -1)
 	{
-		exit(EXIT_FAILURE);
-	}
-	if (WIFEXITED(status)) /* If the child process exited normally*/
-	{
-		int child_exit_status = WEXITSTATUS(status);
-
-		if (child_exit_status == 127)
+		if (errno != EINTR)
 		{
-			exit(127); /* Exit the parent process with status 127 */
+			perror("waitpid");
+			set_last_status(EXIT_FAILURE);
+			return;
 		}
 	}
+	set_last_status(status_from_wait(status));
 }
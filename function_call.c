@@ -0,0 +1,106 @@
+#include "shell.h"
+
+static int call_depth;
+static cf_node *retired_bodies;
+
+/**
+ * drop_function_body - Disposes of a function body that was replaced.
+ * @body: The old body.
+ * Description: While any function runs, the old body may be the very
+ * tree being run (a function can redefine itself), so it is kept on a
+ * list that is freed once the outermost call returns.
+ **/
+void drop_function_body(cf_node *body)
+{
+	cf_node *holder;
+
+	if (body == NULL || call_depth == 0)
+	{
+		cf_free_tree(body);
+		return;
+	}
+	holder = calloc(1, sizeof(cf_node));
+	if (holder == NULL)
+		return;
+	holder->type = CF_FUNCDEF;
+	holder->body = body;
+	holder->next = retired_bodies;
+	retired_bodies = holder;
+}
+
+/**
+ * nesting_enter - Enters a function call or sourced file.
+ * @name: The function or file, for the error message.
+ * @argv: The arguments that were passed to the shell.
+ * Return: 1 if the call can go ahead, 0 if MAX_NESTING calls are already
+ * running; then an error is printed and the status is set to 1.
+ * Description: Runaway recursion stops with an error instead of running
+ * out of stack.
+ **/
+int nesting_enter(char *name, char *argv[])
+{
+	if (call_depth >= MAX_NESTING)
+	{
+		fprintf(stderr, "%s: 1: %s: maximum nesting level exceeded (%d)\n",
+				argv[0], name, MAX_NESTING);
+		set_last_status(EXIT_FAILURE);
+		return (0);
+	}
+	call_depth++;
+	return (1);
+}
+
+/**
+ * nesting_depth - Counts the function calls and sourced files running.
+ * Return: The number of calls entered with nesting_enter and not left.
+ **/
+int nesting_depth(void)
+{
+	return (call_depth);
+}
+
+/**
+ * nesting_leave - Leaves a call entered with nesting_enter.
+ * Description: Leaving the outermost call frees the function bodies
+ * replaced while it ran.
+ **/
+void nesting_leave(void)
+{
+	if (--call_depth == 0)
+	{
+		cf_free_tree(retired_bodies);
+		retired_bodies = NULL;
+	}
+}
+
+/**
+ * call_function - Runs a shell function in-process.
+ * @entry: The function's table entry.
+ * @args: The command words; args[0] is the function name.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Description: The body was parsed when the function was defined, so a
+ * call costs no fork, file access or parsing; only the positional
+ * parameters are swapped for the duration of the call. return ends the
+ * call early; loops around the call can't be left with break or continue
+ * from inside the function.
+ **/
+void call_function(def_entry *entry, char **args, char *argv[],
+		shell_data *data, char **env)
+{
+	char **saved;
+	int loops;
+
+	if (!nesting_enter(args[0], argv))
+		return;
+	saved = swap_positional(args + 1);
+	loops = loop_nesting(0);
+	loop_nesting(-loops);
+	set_last_status(EXIT_SUCCESS);
+	cf_exec_list(entry->func, argv, data, env);
+	clear_jump(JUMP_RETURN);
+	loop_nesting(loops);
+	swap_positional(saved);
+	nesting_leave();
+}
@@ -0,0 +1,164 @@
+#include "shell.h"
+
+/**
+ * heredoc_find - Finds a here-document or here-string operator.
+ * @cmd: The command line.
+ * Return: Pointer to the first "<<" outside quotes, or NULL.
+ **/
+char *heredoc_find(char *cmd)
+{
+	char quote = '\0';
+
+	for (; *cmd != '\0'; cmd++)
+	{
+		if (quote != '\0')
+		{
+			if (*cmd == quote)
+				quote = '\0';
+		}
+		else if (*cmd == '\'' || *cmd == '"')
+			quote = *cmd;
+		else if (cmd[0] == '<' && cmd[1] == '<')
+			return (cmd);
+	}
+	return (NULL);
+}
+
+/**
+ * heredoc_word - Copies the word following a redirection operator.
+ * @s: Pointer to the text after the operator.
+ * @rest: Set to the text following the word.
+ * Return: The malloc'ed word with surrounding quotes removed (an empty
+ * string if there is no word), or NULL on allocation failure.
+ **/
+char *heredoc_word(char *s, char **rest)
+{
+	char *end;
+
+	while (*s == ' ' || *s == '\t')
+		s++;
+	if ((*s == '\'' || *s == '"') && (end = strchr(s + 1, *s)) != NULL)
+	{
+		*rest = end + 1;
+		return (strndup(s + 1, end - s - 1));
+	}
+	*rest = s + strcspn(s, " \t\n;");
+	return (strndup(s, *rest - s));
+}
+
+/**
+ * heredoc_read_body - Reads the lines of a here-document.
+ * @fd: The stream the command came from.
+ * @delim: The line that ends the document.
+ * @strip_tabs: Non-zero for <<- (leading tabs are removed).
+ * @len: Set to the length of the body.
+ * Return: The malloc'ed body, or NULL on allocation failure.
+ * Description: Reaching the end of the stream ends the document too.
+ **/
+char *heredoc_read_body(FILE *fd, const char *delim, int strip_tabs,
+		size_t *len)
+{
+	char line[MAX_CMD_LEN];
+	char *body = NULL, *p;
+	size_t cap = 0;
+
+	*len = 0;
+	if (buf_append(&body, len, &cap, "", 0) == -1)
+		return (NULL);
+	while (fgets(line, MAX_CMD_LEN, fd) != NULL)
+	{
+		p = line;
+		while (strip_tabs && *p == '\t')
+			p++;
+		if (strncmp(p, delim, strlen(delim)) == 0 &&
+				(p[strlen(delim)] == '\n' || p[strlen(delim)] == '\0'))
+			break;
+		if (buf_append(&body, len, &cap, p, strlen(p)) == -1)
+		{
+			free(body);
+			return (NULL);
+		}
+	}
+	return (body);
+}
+
+/**
+ * heredoc_open - Makes a readable descriptor holding a here-document.
+ * @body: The document text.
+ * @len: The length of the text.
+ * Return: A descriptor positioned at the start of the text, or -1.
+ * Description: Bodies that fit in a pipe's atomic write size go through
+ * a pipe; larger ones are written to an anonymous memory file. Nothing
+ * is ever written to disk.
+ **/
+int heredoc_open(const char *body, size_t len)
+{
+	int fds[2], mfd;
+
+	if (len <= PIPE_BUF)
+	{
+		if (pipe2(fds, O_CLOEXEC) == -1)
+			return (-1);
+		if (io_full(fds[1], (char *)body, len, 1) == -1)
+		{
+			close(fds[0]);
+			fds[0] = -1;
+		}
+		close(fds[1]);
+		return (fds[0]);
+	}
+	mfd = memfd_create("heredoc", MFD_CLOEXEC);
+	if (mfd == -1)
+		return (-1);
+	if (io_full(mfd, (char *)body, len, 1) == -1 ||
+			lseek(mfd, 0, SEEK_SET) == -1)
+	{
+		close(mfd);
+		return (-1);
+	}
+	return (mfd);
+}
+
+/**
+ * heredoc_content - Builds the stdin content of a redirection.
+ * @op: Pointer to the "<<" operator in the command line.
+ * @fd: The stream the line came from; here-document lines follow it.
+ * @rest: Set to the text following the redirection.
+ * @len: Set to the length of the content.
+ * @argv: The arguments that were passed to the shell.
+ * Return: The malloc'ed content, or NULL on failure.
+ * Description: Handles "<<WORD", "<<-WORD" (leading tabs stripped) and
+ * "<<< word" (the word followed by a newline). Variables and command
+ * substitutions in the content are expanded, unless the delimiter of a
+ * here-document is quoted or the word of a here-string is single-quoted.
+ **/
+char *heredoc_content(char *op, FILE *fd, char **rest, size_t *len,
+		char *argv[])
+{
+	int here_string = (op[2] == '<'), strip = (op[2] == '-');
+	char *s = op + 2 + (here_string || strip), *word, *body;
+	char quote;
+
+	s += strspn(s, " \t");
+	quote = (*s == '\'' || *s == '"') ? *s : '\0';
+	word = heredoc_word(s, rest);
+	if (word == NULL)
+		return (NULL);
+	if (!here_string)
+		body = heredoc_read_body(fd, word, strip, len);
+	else
+	{
+		*len = strlen(word) + 1;
+		body = malloc(*len + 1);
+		if (body != NULL)
+			sprintf(body, "%s\n", word);
+	}
+	free(word);
+	if (body == NULL || quote == '\'' || (quote != '\0' && !here_string))
+		return (body);
+	word = cf_expand_word(body, argv, 0);
+	free(body);
+	if (word != NULL)
+		*len = strlen(word);
+	return (word);
+}
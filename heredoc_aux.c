@@ -0,0 +1,126 @@
+#include "shell.h"
+
+/**
+ * heredoc_text_body - Copies a here-document body out of a block's text.
+ * @s: The start of the first line of the body.
+ * @delim: The line that ends the document.
+ * @strip_tabs: Non-zero for <<- (leading tabs are removed).
+ * @end: Set to the text following the delimiter line.
+ * Return: The malloc'ed body, or NULL on allocation failure.
+ * Description: Reaching the end of the text ends the document too.
+ **/
+char *heredoc_text_body(char *s, const char *delim, int strip_tabs,
+		char **end)
+{
+	char *body = NULL;
+	size_t len = 0, cap = 0, n, dlen = strlen(delim);
+
+	if (buf_append(&body, &len, &cap, "", 0) == -1)
+		return (NULL);
+	while (*s != '\0')
+	{
+		while (strip_tabs && *s == '\t')
+			s++;
+		n = strcspn(s, "\n");
+		if (n == dlen && strncmp(s, delim, dlen) == 0)
+		{
+			s += n;
+			break;
+		}
+		n += (s[n] == '\n');
+		if (buf_append(&body, &len, &cap, s, n) == -1)
+		{
+			free(body);
+			return (NULL);
+		}
+		s += n;
+	}
+	*end = s;
+	return (body);
+}
+
+/**
+ * cf_here_content - Builds the stdin content of a command in a block.
+ * @node: The CF_SIMPLE node holding a here-document or here-string.
+ * @argv: The arguments that were passed to the shell.
+ * @len: Set to the length of the content.
+ * Return: The malloc'ed content, or NULL on failure.
+ * Description: Here-document bodies are expanded unless their delimiter
+ * was quoted; here-string words are expanded like any other word and
+ * followed by a newline. This happens each time the command runs.
+ **/
+char *cf_here_content(cf_node *node, char *argv[], size_t *len)
+{
+	int string = (node->here_type == TOK_HERESTRING);
+	char *text, *line;
+
+	if (node->here_type == TOK_HEREDOC_RAW)
+		text = strdup(node->here);
+	else
+		text = cf_expand_word(node->here, argv,
+				string ? CF_EXPAND_QUOTES : 0);
+	if (text != NULL && string)
+	{
+		line = malloc(strlen(text) + 2);
+		if (line != NULL)
+			sprintf(line, "%s\n", text);
+		free(text);
+		text = line;
+	}
+	if (text != NULL)
+		*len = strlen(text);
+	return (text);
+}
+
+/**
+ * cf_here_stdin - Points stdin at the here-document of a command.
+ * @node: The CF_SIMPLE node holding a here-document or here-string.
+ * @argv: The arguments that were passed to the shell.
+ * Return: The saved stdin for stdin_restore, or -1 after printing an
+ * error.
+ **/
+int cf_here_stdin(cf_node *node, char *argv[])
+{
+	char *here;
+	size_t len;
+	int fd;
+
+	here = cf_here_content(node, argv, &len);
+	fd = (here != NULL) ? heredoc_open(here, len) : -1;
+	free(here);
+	fd = (fd != -1) ? stdin_replace(fd) : -1;
+	if (fd == -1)
+		perror("here-document");
+	return (fd);
+}
+
+/**
+ * stdin_replace - Points the shell's stdin at a descriptor.
+ * @fd: The descriptor, closed once it has been duplicated.
+ * Return: A close-on-exec copy of the previous stdin for stdin_restore,
+ * or -1 on failure.
+ **/
+int stdin_replace(int fd)
+{
+	int saved;
+
+	fflush(stdout);
+	saved = fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 0);
+	if (saved != -1 && dup2(fd, STDIN_FILENO) == -1)
+	{
+		close(saved);
+		saved = -1;
+	}
+	close(fd);
+	return (saved);
+}
+
+/**
+ * stdin_restore - Puts back the stdin saved by stdin_replace.
+ * @saved: The descriptor returned by stdin_replace.
+ **/
+void stdin_restore(int saved)
+{
+	dup2(saved, STDIN_FILENO);
+	close(saved);
+}
@@ -0,0 +1,93 @@
+#include "shell.h"
+
+/**
+ * history_enable - Turns command history back on.
+ * @data: Pointer to the shell_data struct.
+ * Description: History is on unless it was turned off with HISTORY_OFF,
+ * as the non-interactive modes do. Only marks history as wanted; the
+ * history file is not opened until the first lookup (see read_history).
+ **/
+void history_enable(shell_data *data)
+{
+	if (data->history_state == HISTORY_OFF)
+		data->history_state = HISTORY_LAZY;
+	data->history_writer = 0;
+}
+
+/**
+ * history_merge_pending - Re-inserts commands entered before the load.
+ * @data: Pointer to the shell_data struct.
+ * @pending: The list as it was before the file was loaded, newest first.
+ * Description: Entries are re-inserted oldest first so that they end up
+ * above the ones read from the file, then the old nodes are freed.
+ **/
+void history_merge_pending(shell_data *data, Node *pending)
+{
+	Node *nodes[HISTORY_COUNT];
+	Node *next;
+	int count = 0;
+
+	while (pending != NULL)
+	{
+		next = pending->next;
+		if (count < HISTORY_COUNT)
+			nodes[count++] = pending;
+		else
+			free(pending);
+		pending = next;
+	}
+	while (count > 0)
+	{
+		insert_cmd(data, nodes[--count]->cmd);
+		free(nodes[count]);
+	}
+}
+
+/**
+ * history_get - Looks up a command in the history list.
+ * @data: Pointer to the shell_data struct.
+ * @n: Index of the command, 0 being the most recent.
+ * Return: The command string, or NULL if there is no such entry.
+ * Description: Loads the history file the first time it is needed.
+ **/
+const char *history_get(shell_data *data, int n)
+{
+	Node *current;
+
+	read_history(data);
+	for (current = data->head; current != NULL && n > 0; n--)
+		current = current->next;
+	return (current != NULL ? current->cmd : NULL);
+}
+
+/**
+ * history_flush - Persists the history list without blocking the shell.
+ * @data: Pointer to the shell_data struct.
+ * Description: Nothing is written if history is disabled or unchanged.
+ * Otherwise the list is loaded (so the file isn't truncated to the new
+ * entries) and written by a forked child working on its own copy, while
+ * the shell carries on. The previous writer is reaped first.
+ **/
+void history_flush(shell_data *data)
+{
+	pid_t pid;
+
+	if (data->history_state == HISTORY_OFF || !data->history_dirty)
+		return;
+	read_history(data);
+	if (data->history_writer > 0)
+		waitpid(data->history_writer, NULL, 0);
+	pid = fork();
+	if (pid == 0)
+	{
+		write_history(data);
+		_exit(EXIT_SUCCESS);
+	}
+	if (pid < 0)
+	{
+		write_history(data);
+		pid = 0;
+	}
+	data->history_writer = pid;
+	data->history_dirty = 0;
+}
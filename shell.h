@@ -1,6 +1,8 @@
 #ifndef SHELL_H
 #define SHELL_H
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,10 +15,33 @@
 #include <limits.h>
 #include <pwd.h>
 #include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <fnmatch.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
 
 #define MAX_CMD_LEN 10240
 #define HISTORY_COUNT 10
 #define HISTORY_FILE "history.txt"
+#define HISTORY_LAZY 0
+#define HISTORY_LOADED 1
+#define HISTORY_OFF 2
+#define CF_MAX_ARGS 1024
+#define MAX_NESTING 256
+#define DEF_TABLE_SIZE 64
+#define TIMEOUT_KILL_AFTER 1000
+#define TIMEOUT_POLL_STEP 10
+#define ULIMIT_SOFT 1
+#define ULIMIT_HARD 2
+#define STREAM_BUFFER_SIZE (64 * 1024)
+#define DAEMON_BACKLOG 128
+#define DAEMON_MAX_REQUEST (64 * 1024 * 1024)
+
+extern char **environ;
 
 
 /**
@@ -36,15 +61,174 @@ typedef struct Node
 /**
  * struct shell_data - Shell data structure.
  * @head: Pointer to the head node of the linked list.
+ * @history_state: HISTORY_LAZY (file not read yet), HISTORY_LOADED or
+ * HISTORY_OFF.
+ * @history_dirty: Non-zero when the list has changes not yet flushed.
+ * @history_writer: PID of the last background history writer, or 0.
  * Description: This structure represents the shell data. It contains a pointer
  * `head` to the head node of a linked list. The linked list
- * stores commands, where each node represents a command in the list
+ * stores commands, where each node represents a command in the list.
+ * Zero-initialising the structure leaves history on, as it always was;
+ * the non-interactive modes set @history_state to HISTORY_OFF.
  **/
 typedef struct shell_data
 {
 	Node *head;
+	int history_state;
+	int history_dirty;
+	pid_t history_writer;
 } shell_data;
 
+/**
+ * struct daemon_request - Request sent by a daemon client.
+ * @payload: NUL-separated records, each starting with a type character:
+ * 'C' working directory, 'E' environment entry, 'S' command string,
+ * 'F' command file.
+ * @len: Size of the payload in bytes.
+ * @fds: The client's stdin, stdout and stderr, received over the socket.
+ * Description: The daemon handler installs @fds as its own standard
+ * streams and applies the records in order.
+ **/
+typedef struct daemon_request
+{
+	char *payload;
+	size_t len;
+	int fds[3];
+} daemon_request;
+
+/* Control flow token types */
+#define TOK_WORD 0
+#define TOK_SEP 1
+#define TOK_DSEMI 2
+#define TOK_RPAREN 3
+#define TOK_EOF 4
+#define TOK_HEREDOC 5
+#define TOK_HEREDOC_RAW 6
+#define TOK_HERESTRING 7
+
+/* Control flow node types */
+#define CF_SIMPLE 0
+#define CF_IF 1
+#define CF_ELIF 2
+#define CF_WHILE 3
+#define CF_UNTIL 4
+#define CF_FOR 5
+#define CF_CASE 6
+#define CF_ARM 7
+#define CF_FUNCDEF 8
+
+/* Control flow parse results */
+#define CF_OK 0
+#define CF_INCOMPLETE 1
+#define CF_ERROR 2
+
+/* Word expansion flags, and the byte that marks where a word splits */
+#define CF_EXPAND_QUOTES 1
+#define CF_EXPAND_SPLIT 2
+#define CF_EXPAND_QUOTED 4
+#define CF_FIELD_SEP '\037'
+
+/* Pending jumps that unwind running commands */
+#define JUMP_NONE 0
+#define JUMP_BREAK 1
+#define JUMP_CONTINUE 2
+#define JUMP_RETURN 3
+#define JUMP_EXIT 4
+
+/**
+ * struct cf_token - Token of a control block.
+ * @type: One of the TOK_* types.
+ * @text: The word for TOK_WORD tokens, the body of a here-document
+ * (TOK_HEREDOC, or TOK_HEREDOC_RAW when the delimiter was quoted), the
+ * word of a here-string (TOK_HERESTRING), NULL otherwise.
+ **/
+typedef struct cf_token
+{
+	int type;
+	char *text;
+} cf_token;
+
+/**
+ * struct cf_node - Node of a parsed control block.
+ * @type: One of the CF_* node types.
+ * @words: Command words (CF_SIMPLE), loop items (CF_FOR), the subject
+ * word (CF_CASE) or the patterns (CF_ARM).
+ * @name: The loop variable of a CF_FOR node, the name of a CF_FUNCDEF.
+ * @cond: The condition list of an if, elif, while or until.
+ * @body: The commands run by the node.
+ * @alt: The elif node or else list of an if, the arms of a case.
+ * @next: The next node in the same list.
+ * @here: The here-document body or here-string word fed to the stdin of
+ * a CF_SIMPLE node, or NULL.
+ * @here_type: The TOK_HEREDOC* or TOK_HERESTRING type of @here.
+ * Description: Blocks are parsed once into a tree of these nodes and
+ * then run without going back to the text.
+ **/
+typedef struct cf_node
+{
+	int type;
+	char **words;
+	char *name;
+	struct cf_node *cond;
+	struct cf_node *body;
+	struct cf_node *alt;
+	struct cf_node *next;
+	char *here;
+	int here_type;
+} cf_node;
+
+/**
+ * struct cf_parser - Parser state for a control block.
+ * @toks: The token array, terminated by a TOK_EOF token.
+ * @pos: Index of the current token.
+ * @status: CF_OK, CF_INCOMPLETE or CF_ERROR.
+ **/
+typedef struct cf_parser
+{
+	cf_token *toks;
+	int pos;
+	int status;
+} cf_parser;
+
+/**
+ * struct def_entry - Function and alias definitions for one name.
+ * @name: The function or alias name.
+ * @func: The parsed function body, or NULL.
+ * @alias: The alias text as defined, or NULL.
+ * @alias_buf: Buffer holding the words of the alias.
+ * @alias_words: NULL-terminated words of the alias, split once when the
+ * alias is defined.
+ * @expanding: Non-zero while the alias's own expansion runs.
+ * @next: The next entry in the same hash bucket.
+ **/
+typedef struct def_entry
+{
+	char *name;
+	cf_node *func;
+	char *alias;
+	char *alias_buf;
+	char **alias_words;
+	int expanding;
+	struct def_entry *next;
+} def_entry;
+
+/**
+ * struct child_limit - Resource limit applied to commands the shell runs.
+ * @opt: The ulimit option letter.
+ * @resource: The RLIMIT_* resource.
+ * @unit: Bytes (or other units) per unit given to ulimit.
+ * @value: The limit, in the resource's own units.
+ * @set: 0 if unset, ULIMIT_SOFT or ULIMIT_HARD.
+ **/
+typedef struct child_limit
+{
+	char opt;
+	int resource;
+	rlim_t unit;
+	rlim_t value;
+	int set;
+} child_limit;
+
 char *_trim(char *str);
 int _isspace(char c);
 int is_whitespace(char c);
@@ -64,12 +248,14 @@ void unset_env_var(char *name, char ***env);
 void execute_cmd(char **cmd, char *argv[], shell_data *data, char **env);
 void execute_cd_command(char *args[], char **env);
 void execute_other_command(char *args[], char *argv[], char **env);
-void execute_command_in_path(char *args[], char *error_message,
-		int *length, char **env);
+int execute_command_in_path(char *args[], char **env);
 void execute_cd(char **args, char **env);
 void execute_env(char **args, char **env);
 void execute_setenv(char **args, char **env);
 void execute_unsetenv(char **args, char **env);
+int is_builtin(const char *name);
+int run_shell_builtin(char **args, char *argv[], shell_data *data,
+		char **env);
 
 /* Command existence check function */
 int command_exists(char *cmd, char **env);
@@ -77,8 +263,12 @@ int command_exists(char *cmd, char **env);
 /* Process handling functions */
 void handle_fork_error(void);
 void handle_child_process(char *args[], char *argv[],
-		char *error_message, int length, char **env);
+		int status_fd, char **env);
 void handle_parent_process(pid_t pid);
+int read_exec_status(int fd);
+int exec_failure_status(int err);
+void report_exec_error(char *argv[], char *args[], int err);
+int exec_file(char *file, char *args[]);
 
 /* Error message printing function */
 void print_error_message(char *argv[], char *args[],
@@ -98,12 +288,147 @@ void split_and_execute_cmd(char *trim_cmd, char *argv[],
 		shell_data *data, char **env);
 void reset_args(char *args[], int *arg_count);
 
-/* Command history functions */
+/* Command substitution functions */
+char *substitution_end(char *s, char open);
+int substitution_in_process(char *cmd);
+int buf_append(char **buf, size_t *len, size_t *cap,
+		const char *data, size_t n);
+int append_split_output(char **buf, size_t *len, size_t *cap, char *out,
+		char sep);
+char *capture_output(char *inner, size_t n, char *argv[], char **env);
+char *capture_builtin_output(char *cmd, char *argv[], char **env);
+char *capture_external_output(char *cmd, char *argv[], char **env);
+void run_substitution_child(char *cmd, char *argv[], char **env);
+char *read_fd_all(int fd);
+
+/* Control flow functions */
+int is_control_start(const char *line);
+void run_control_block(char *line, FILE *fd, char *argv[],
+		shell_data *data, char **env);
+int cf_line_depth(char *line);
+int cf_block_add_line(char *line, FILE *fd, char **text, size_t *len,
+		size_t *cap);
+int cf_word_in(const char *word, const char *const *list);
+cf_token *cf_lex(char *s);
+char *cf_lex_word(char **s);
+char *cf_quote_end(char *p);
+int cf_is_escape(char *p, int flags);
+int cf_lex_redirect(char **s, char **resume, cf_token **toks, int *count);
+int cf_add_token(cf_token **toks, int *count, int type, char *text);
+void cf_free_tokens(cf_token *toks, int count);
+cf_node *cf_parse(char *text, int *status);
+cf_node *cf_parse_list(cf_parser *p, const char *const *stops);
+cf_node *cf_parse_command(cf_parser *p);
+cf_node *cf_parse_simple(cf_parser *p);
+cf_node *cf_parse_if(cf_parser *p);
+cf_node *cf_parse_loop(cf_parser *p);
+cf_node *cf_parse_for(cf_parser *p);
+cf_node *cf_parse_case(cf_parser *p);
+cf_node *cf_parse_arm(cf_parser *p);
+cf_node *cf_parse_function(cf_parser *p);
+int cf_is_function_start(cf_parser *p);
+int cf_is_word(cf_parser *p, const char *word);
+int cf_expect(cf_parser *p, const char *word);
+cf_node *cf_new_node(cf_parser *p, int type);
+char **cf_copy_words(cf_parser *p, int start, int end);
+void cf_free_tree(cf_node *node);
+cf_node *cf_copy_tree(cf_node *node);
+cf_node *cf_copy_node(cf_node *node, int *failed);
+char **cf_copy_strings(char **words, int *failed);
+int cf_exec_list(cf_node *node, char *argv[], shell_data *data, char **env);
+int cf_exec_node(cf_node *node, char *argv[], shell_data *data, char **env);
+int cf_exec_simple(cf_node *node, char *argv[], shell_data *data, char **env);
+int cf_exec_for(cf_node *node, char *argv[], shell_data *data, char **env);
+int cf_exec_while(cf_node *node, char *argv[], shell_data *data, char **env);
+void set_jump(int type, int count);
+int jump_pending(void);
+int clear_jump(int type);
+int loop_jump(void);
+int loop_nesting(int delta);
+int jump_number(char **args, long *value, long min);
+void execute_exit(char **args);
+void execute_break(char **args);
+void execute_return(char **args);
+int cf_exec_case(cf_node *node, char *argv[], shell_data *data, char **env);
+char *cf_expand_word(char *word, char *argv[], int flags);
+char *cf_expand_special(char *s, char **buf, size_t *len, size_t *cap,
+		int flags);
+char *cf_expand_var(char *s, char **buf, size_t *len, size_t *cap, int flags);
+int cf_expand_subst(char **p, char **out, char *argv[]);
+int cf_expand_args(char **words, char **out, char **bufs, int max,
+		char *argv[]);
+
+/* Function and alias functions */
+unsigned int def_hash(const char *name);
+def_entry *def_lookup(const char *name, int create);
+void define_function(const char *name, cf_node *body);
+void drop_function_body(cf_node *body);
+int nesting_enter(char *name, char *argv[]);
+void nesting_leave(void);
+int nesting_depth(void);
+int define_alias(const char *name, const char *value);
+void print_aliases(void);
+char **swap_positional(char **args);
+char *get_positional(int n);
+void set_shell_name(char *name);
+int count_positional(void);
+void call_function(def_entry *entry, char **args, char *argv[],
+		shell_data *data, char **env);
+int run_definition(char **args, char *argv[], shell_data *data, char **env);
+int alias_assignment(char **args, int *used);
+void execute_alias(char **args);
+void execute_unalias(char **args);
+void execute_source(char **args, char *argv[], shell_data *data, char **env);
+
+/* Timeout and ulimit functions */
+long parse_duration(const char *s);
+int wait_child(pid_t pid, int pidfd, long ms);
+void run_timed_child(char **args, char *argv[], shell_data *data, char **env);
+void timeout_kill(pid_t pid, int pidfd);
+void execute_timeout(char **args, char *argv[], shell_data *data, char **env);
+child_limit *find_limit(char opt);
+void apply_child_limits(void);
+int parse_limit(const char *arg, child_limit *limit, rlim_t *value);
+int check_limit(child_limit *limit, rlim_t value, int hard);
+void print_limit(child_limit *limit);
+void execute_ulimit(char **args);
+
+/* Here-document functions */
+char *heredoc_find(char *cmd);
+char *heredoc_word(char *s, char **rest);
+char *heredoc_read_body(FILE *fd, const char *delim, int strip_tabs,
+		size_t *len);
+int heredoc_open(const char *body, size_t len);
+char *heredoc_text_body(char *s, const char *delim, int strip_tabs,
+		char **end);
+char *cf_here_content(cf_node *node, char *argv[], size_t *len);
+int cf_here_stdin(cf_node *node, char *argv[]);
+int stdin_replace(int fd);
+void stdin_restore(int saved);
+char *heredoc_content(char *op, FILE *fd, char **rest, size_t *len,
+		char *argv[]);
+void run_with_heredoc(char *cmd, FILE *fd, char *argv[],
+		shell_data *data, char **env);
+void run_command_line(char *cmd, char *argv[], shell_data *data, char **env);
+
+/*
+ * Command history functions
+ * The interactive loop (main.c and interactive_shell_operations.c in the
+ * makefile, not part of this source tree) keeps its old calls to
+ * check_history_file, read_history, insert_cmd and write_history, which
+ * work as before. history_get (loads the file on first lookup) and
+ * history_flush (writes it in the background, and may be called after
+ * every command) are available to it but not required.
+ */
 void check_history_file(void);
 void insert_cmd(shell_data *data, const char *cmd);
 void clear_history(shell_data *data);
 void write_history(shell_data *data);
 void read_history(shell_data *data);
+void history_enable(shell_data *data);
+void history_merge_pending(shell_data *data, Node *pending);
+const char *history_get(shell_data *data, int n);
+void history_flush(shell_data *data);
 
 /* Command mode functions */
 void execute_commands_from_file(int argc, char *argv[],
@@ -111,6 +436,36 @@ void execute_commands_from_file(int argc, char *argv[],
 void execute_commands_interactively(char *cmd, size_t len,
 		char *argv[], shell_data *data, char **env);
 
+/* Exit status functions */
+void set_last_status(int status);
+int get_last_status(void);
+int status_from_wait(int status);
+void errexit_check(int status);
+int errexit_tripped(void);
+int cf_exec_cond(cf_node *node, char *argv[], shell_data *data, char **env);
+void set_errexit(int on);
+void execute_set(char **args);
+
+/* Shell mode functions */
+int dispatch_shell_mode(int argc, char *argv[], shell_data *data, char **env);
+int print_usage(char *argv[]);
+int run_command_stream(FILE *fp, char *argv[], char **env);
+int run_command_string(char *cmd, char *argv[], char **env);
+
+/* Daemon functions */
+int daemon_serve(const char *path, char *argv[]);
+int daemon_open_socket(const char *path);
+int daemon_clear_path(struct sockaddr_un *addr);
+int daemon_handle_connection(int conn, char *argv[]);
+int daemon_run_request(daemon_request *req, char *argv[]);
+int daemon_client(const char *path, char tag, const char *arg);
+char *daemon_build_payload(char tag, const char *arg, size_t *len);
+int payload_append(char **buf, size_t *len, size_t *cap,
+		char tag, const char *str);
+int daemon_send_request(int sfd, char *payload, size_t len);
+int daemon_recv_request(int conn, daemon_request *req);
+int io_full(int fd, char *buf, size_t len, int writing);
+
 /* Prompt printing function */
 void print_prompt(void);
 
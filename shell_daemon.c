@@ -0,0 +1,227 @@
+#include "shell.h"
+
+/**
+ * daemon_clear_path - Removes a stale socket left at the daemon's path.
+ * @addr: The address the daemon is about to bind.
+ * Return: 0 if the path is free, -1 if it must not be replaced.
+ * Description: Only a socket nobody is listening on is removed; a regular
+ * file (or anything else) at the path, or a socket a running daemon
+ * still accepts connections on, is left alone.
+ **/
+int daemon_clear_path(struct sockaddr_un *addr)
+{
+	struct stat st;
+	int probe, live;
+
+	if (lstat(addr->sun_path, &st) == -1)
+	{
+		if (errno == ENOENT)
+			return (0);
+		perror("daemon");
+		return (-1);
+	}
+	if (!S_ISSOCK(st.st_mode))
+	{
+		write(STDERR_FILENO, "daemon: path exists and is not a socket\n",
+				40);
+		return (-1);
+	}
+	probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (probe == -1)
+	{
+		perror("socket");
+		return (-1);
+	}
+	live = connect(probe, (struct sockaddr *)addr, sizeof(*addr)) == 0;
+	close(probe);
+	if (live)
+	{
+		write(STDERR_FILENO, "daemon: socket already in use\n", 30);
+		return (-1);
+	}
+	if (unlink(addr->sun_path) == -1)
+	{
+		perror("daemon");
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * daemon_open_socket - Creates the listening Unix domain socket.
+ * @path: Filesystem path to bind the socket to.
+ * Return: The listening socket descriptor, or -1 on failure.
+ * Description: A stale socket left behind by a previous server is
+ * removed before binding so that the daemon can be restarted in place
+ * (see daemon_clear_path).
+ * The socket is created with mode 0600 whatever the umask, so only its
+ * owner can connect.
+ **/
+int daemon_open_socket(const char *path)
+{
+	struct sockaddr_un addr;
+	mode_t old_mask;
+	int sfd, err;
+
+	if (strlen(path) >= sizeof(addr.sun_path))
+	{
+		write(STDERR_FILENO, "daemon: socket path too long\n", 29);
+		return (-1);
+	}
+	sfd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sfd == -1)
+	{
+		perror("socket");
+		return (-1);
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	if (daemon_clear_path(&addr) == -1)
+	{
+		close(sfd);
+		return (-1);
+	}
+	old_mask = umask(0177);
+	err = bind(sfd, (struct sockaddr *)&addr, sizeof(addr));
+	umask(old_mask);
+	if (err == -1 || listen(sfd, DAEMON_BACKLOG) == -1)
+	{
+		perror("daemon");
+		close(sfd);
+		return (-1);
+	}
+	return (sfd);
+}
+
+/**
+ * daemon_run_request - Executes the records of a client request.
+ * @req: The request received from the client.
+ * @argv: The arguments that were passed to the shell.
+ * Return: The exit status of the last command that was run.
+ * Description: Records are applied in order: 'C' changes directory
+ * (the request fails without running anything if it can't), 'E' adds an environment entry (the environment is first cleared so the
+ * child sees exactly the client's environment), 'S' runs a command string
+ * and 'F' runs a command file.
+ **/
+int daemon_run_request(daemon_request *req, char *argv[])
+{
+	char *rec = req->payload;
+	FILE *fp;
+
+	clearenv();
+	while (rec < req->payload + req->len)
+	{
+		if (rec[0] == 'C' && chdir(rec + 1) == -1)
+		{
+			perror("cd");
+			return (EXIT_FAILURE);
+		}
+		else if (rec[0] == 'E')
+			putenv(rec + 1);
+		else if (rec[0] == 'S')
+			run_command_string(rec + 1, argv, environ);
+		else if (rec[0] == 'F')
+		{
+			fp = fopen(rec + 1, "r");
+			if (fp == NULL)
+			{
+				perror("Failed to open command file");
+				return (EXIT_FAILURE);
+			}
+			run_command_stream(fp, argv, environ);
+			fclose(fp);
+		}
+		rec += strlen(rec) + 1;
+	}
+	return (get_last_status());
+}
+
+/**
+ * daemon_handle_connection - Serves a single client connection.
+ * @conn: The connected client socket.
+ * @argv: The arguments that were passed to the shell.
+ * Return: The exit status that was reported to the client.
+ * Description: Runs in a process forked from the pre-warmed server. The
+ * client's stdin, stdout and stderr are installed in place of our own so
+ * output streams straight to the caller without passing through the socket,
+ * which only carries the final exit status back. Clients running as
+ * another user are turned away before anything is read from them.
+ **/
+int daemon_handle_connection(int conn, char *argv[])
+{
+	daemon_request req;
+	struct ucred cred;
+	socklen_t cred_len = sizeof(cred);
+	int i, status;
+
+	if (getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &cred_len) == -1 ||
+			cred.uid != geteuid())
+	{
+		write(STDERR_FILENO, "daemon: connection from another user refused\n",
+				45);
+		close(conn);
+		return (EXIT_FAILURE);
+	}
+	if (daemon_recv_request(conn, &req) == -1)
+	{
+		close(conn);
+		return (EXIT_FAILURE);
+	}
+	for (i = 0; i < 3; i++)
+	{
+		dup2(req.fds[i], i);
+		close(req.fds[i]);
+	}
+	status = daemon_run_request(&req, argv);
+	fflush(stdout);
+	if (write(conn, &status, sizeof(status)) != sizeof(status))
+		perror("daemon: failed to send status");
+	free(req.payload);
+	close(conn);
+	return (status);
+}
+
+/**
+ * daemon_serve - Runs the shell as a persistent server.
+ * @path: Filesystem path of the Unix domain socket to listen on.
+ * @argv: The arguments that were passed to the shell.
+ * Return: EXIT_FAILURE if the server could not be started or stopped
+ * accepting connections.
+ * Description: Startup work is done once by this process; every
+ * connection is handled by a forked copy, so clients skip it entirely.
+ * Finished handlers are reaped between accepts.
+ **/
+int daemon_serve(const char *path, char *argv[])
+{
+	int sfd, conn;
+	pid_t pid;
+
+	sfd = daemon_open_socket(path);
+	if (sfd == -1)
+		return (EXIT_FAILURE);
+	while (1)
+	{
+		conn = accept4(sfd, NULL, NULL, SOCK_CLOEXEC);
+		if (conn == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			perror("accept");
+			break;
+		}
+		pid = fork();
+		if (pid == 0)
+		{
+			close(sfd);
+			_exit(daemon_handle_connection(conn, argv));
+		}
+		if (pid < 0)
+			perror("Fork failed");
+		close(conn);
+		while (waitpid(-1, NULL, WNOHANG) > 0)
+			;
+	}
+	close(sfd);
+	return (EXIT_FAILURE);
+}
@@ -0,0 +1,103 @@
+#include "shell.h"
+
+/**
+ * payload_append - Appends a tagged record to a request payload.
+ * @buf: Pointer to the growable payload buffer.
+ * @len: Pointer to the number of bytes used in @buf.
+ * @cap: Pointer to the allocated size of @buf.
+ * @tag: The record type character.
+ * @str: The record value.
+ * Return: 0 on success, -1 if memory could not be allocated.
+ **/
+int payload_append(char **buf, size_t *len, size_t *cap,
+		char tag, const char *str)
+{
+	size_t need = strlen(str) + 2;
+	char *tmp;
+
+	while (*len + need > *cap)
+	{
+		tmp = realloc(*buf, *cap * 2 + need);
+		if (tmp == NULL)
+			return (-1);
+		*buf = tmp;
+		*cap = *cap * 2 + need;
+	}
+	(*buf)[(*len)++] = tag;
+	strcpy(*buf + *len, str);
+	*len += need - 1;
+	return (0);
+}
+
+/**
+ * daemon_build_payload - Builds the request payload for the daemon.
+ * @tag: 'S' to run a command string, 'F' to run a command file.
+ * @arg: The command string or file name.
+ * @len: Set to the size of the returned payload.
+ * Return: The malloc'ed payload, or NULL on failure.
+ * Description: The payload carries our working directory and environment
+ * so that the command runs as if this process had executed it.
+ **/
+char *daemon_build_payload(char tag, const char *arg, size_t *len)
+{
+	char cwd[PATH_MAX];
+	char *buf = NULL;
+	size_t cap = 0;
+	int i, err = 0;
+
+	*len = 0;
+	if (getcwd(cwd, sizeof(cwd)) == NULL)
+	{
+		perror("getcwd");
+		return (NULL);
+	}
+	err |= payload_append(&buf, len, &cap, 'C', cwd);
+	for (i = 0; environ[i] != NULL; i++)
+		err |= payload_append(&buf, len, &cap, 'E', environ[i]);
+	err |= payload_append(&buf, len, &cap, tag, arg);
+	if (err)
+	{
+		write(STDERR_FILENO, "Failed to allocate memory\n", 26);
+		free(buf);
+		return (NULL);
+	}
+	return (buf);
+}
+
+/**
+ * daemon_client - Runs a command string or file through a shell daemon.
+ * @path: Filesystem path of the daemon's Unix domain socket.
+ * @tag: 'S' to run a command string, 'F' to run a command file.
+ * @arg: The command string or file name.
+ * Return: The exit status of the command as reported by the daemon,
+ * or EXIT_FAILURE if the daemon could not be reached.
+ **/
+int daemon_client(const char *path, char tag, const char *arg)
+{
+	struct sockaddr_un addr;
+	char *payload;
+	size_t len;
+	int sfd, status = EXIT_FAILURE;
+
+	if (strlen(path) >= sizeof(addr.sun_path))
+		return (EXIT_FAILURE);
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	payload = daemon_build_payload(tag, arg, &len);
+	if (payload == NULL)
+		return (EXIT_FAILURE);
+	sfd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sfd == -1 ||
+			connect(sfd, (struct sockaddr *)&addr, sizeof(addr)) == -1 ||
+			daemon_send_request(sfd, payload, len) == -1 ||
+			io_full(sfd, (char *)&status, sizeof(status), 0) == -1)
+	{
+		perror("daemon client");
+		status = EXIT_FAILURE;
+	}
+	if (sfd != -1)
+		close(sfd);
+	free(payload);
+	return (status);
+}
@@ -0,0 +1,111 @@
+#include "shell.h"
+
+/**
+ * io_full - Transfers exactly @len bytes over a descriptor.
+ * @fd: The descriptor to read from or write to.
+ * @buf: The buffer holding or receiving the data.
+ * @len: The number of bytes to transfer.
+ * @writing: Non-zero to write, zero to read.
+ * Return: 0 on success, -1 on error or premature end of file.
+ **/
+int io_full(int fd, char *buf, size_t len, int writing)
+{
+	ssize_t n;
+
+	while (len > 0)
+	{
+		if (writing)
+			n = write(fd, buf, len);
+		else
+			n = read(fd, buf, len);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (-1);
+		buf += n;
+		len -= n;
+	}
+	return (0);
+}
+
+/**
+ * daemon_send_request - Sends a request to the daemon.
+ * @sfd: The connected socket.
+ * @payload: NUL-separated request records.
+ * @len: Size of the payload in bytes.
+ * Return: 0 on success, -1 on failure.
+ * Description: The payload length travels with the caller's stdin, stdout
+ * and stderr (passed as SCM_RIGHTS) in a single message; the payload
+ * itself follows as plain stream data.
+ **/
+int daemon_send_request(int sfd, char *payload, size_t len)
+{
+	union {
+		struct cmsghdr hdr;
+		char buf[CMSG_SPACE(3 * sizeof(int))];
+	} ctl;
+	struct msghdr msg;
+	struct iovec iov;
+	unsigned int hdr_len = len;
+	int fds[3] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+
+	memset(&msg, 0, sizeof(msg));
+	memset(&ctl, 0, sizeof(ctl));
+	iov.iov_base = &hdr_len;
+	iov.iov_len = sizeof(hdr_len);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctl.buf;
+	msg.msg_controllen = sizeof(ctl.buf);
+	CMSG_FIRSTHDR(&msg)->cmsg_level = SOL_SOCKET;
+	CMSG_FIRSTHDR(&msg)->cmsg_type = SCM_RIGHTS;
+	CMSG_FIRSTHDR(&msg)->cmsg_len = CMSG_LEN(sizeof(fds));
+	memcpy(CMSG_DATA(CMSG_FIRSTHDR(&msg)), fds, sizeof(fds));
+	if (sendmsg(sfd, &msg, 0) != sizeof(hdr_len))
+		return (-1);
+	return (io_full(sfd, payload, len, 1));
+}
+
+/**
+ * daemon_recv_request - Receives a request sent by daemon_send_request.
+ * @conn: The connected client socket.
+ * @req: Filled in with the payload and the client's descriptors.
+ * Return: 0 on success, -1 on failure.
+ **/
+int daemon_recv_request(int conn, daemon_request *req)
+{
+	union {
+		struct cmsghdr hdr;
+		char buf[CMSG_SPACE(3 * sizeof(int))];
+	} ctl;
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cm;
+	unsigned int hdr_len;
+
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = &hdr_len;
+	iov.iov_len = sizeof(hdr_len);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctl.buf;
+	msg.msg_controllen = sizeof(ctl.buf);
+	if (recvmsg(conn, &msg, MSG_CMSG_CLOEXEC) != sizeof(hdr_len))
+		return (-1);
+	cm = CMSG_FIRSTHDR(&msg);
+	if (cm == NULL || cm->cmsg_type != SCM_RIGHTS ||
+			cm->cmsg_len != CMSG_LEN(sizeof(req->fds)) ||
+			hdr_len == 0 || hdr_len > DAEMON_MAX_REQUEST)
+		return (-1);
+	memcpy(req->fds, CMSG_DATA(cm), sizeof(req->fds));
+	req->len = hdr_len;
+	req->payload = malloc(hdr_len + 1);
+	if (req->payload == NULL ||
+			io_full(conn, req->payload, hdr_len, 0) == -1)
+	{
+		free(req->payload);
+		return (-1);
+	}
+	req->payload[hdr_len] = '\0';
+	return (0);
+}
@@ -0,0 +1,129 @@
+#include "shell.h"
+
+static def_entry *def_table[DEF_TABLE_SIZE];
+static int def_count;
+
+/**
+ * def_hash - Hashes a function or alias name.
+ * @name: The name to hash.
+ * Return: The bucket index for @name.
+ **/
+unsigned int def_hash(const char *name)
+{
+	unsigned long hash = 5381;
+
+	while (*name != '\0')
+		hash = hash * 33 + (unsigned char)*name++;
+	return (hash % DEF_TABLE_SIZE);
+}
+
+/**
+ * def_lookup - Finds the definitions registered under a name.
+ * @name: The function or alias name.
+ * @create: Non-zero to create an empty entry if there is none.
+ * Return: The entry, or NULL if there is none (or it can't be created).
+ * Description: Called for every command the shell runs, so the common
+ * case of a script defining nothing is answered without hashing.
+ **/
+def_entry *def_lookup(const char *name, int create)
+{
+	def_entry *entry;
+	unsigned int bucket;
+
+	if (def_count == 0 && !create)
+		return (NULL);
+	bucket = def_hash(name);
+	for (entry = def_table[bucket]; entry != NULL; entry = entry->next)
+	{
+		if (strcmp(entry->name, name) == 0)
+			return (entry);
+	}
+	if (!create)
+		return (NULL);
+	entry = calloc(1, sizeof(def_entry));
+	if (entry == NULL || (entry->name = strdup(name)) == NULL)
+	{
+		free(entry);
+		write(STDERR_FILENO, "Failed to allocate memory\n", 26);
+		return (NULL);
+	}
+	entry->next = def_table[bucket];
+	def_table[bucket] = entry;
+	def_count++;
+	return (entry);
+}
+
+/**
+ * define_function - Registers a shell function.
+ * @name: The function name.
+ * @body: The parsed body; the table takes ownership of it.
+ * Description: Redefining a function replaces its previous body, which
+ * is freed once it can no longer be running.
+ **/
+void define_function(const char *name, cf_node *body)
+{
+	def_entry *entry = def_lookup(name, 1);
+
+	if (entry == NULL)
+	{
+		cf_free_tree(body);
+		return;
+	}
+	drop_function_body(entry->func);
+	entry->func = body;
+}
+
+/**
+ * define_alias - Registers an alias.
+ * @name: The alias name.
+ * @value: The replacement text, or NULL to remove the alias.
+ * Return: 0 on success, -1 on failure.
+ * Description: The replacement is split into words once, here, so that
+ * expanding the alias never re-tokenizes it.
+ **/
+int define_alias(const char *name, const char *value)
+{
+	def_entry *entry = def_lookup(name, value != NULL);
+	char *save;
+	int n = 0;
+
+	if (entry == NULL)
+		return (value == NULL ? -1 : 0);
+	free(entry->alias);
+	free(entry->alias_buf);
+	free(entry->alias_words);
+	entry->alias = NULL;
+	entry->alias_buf = NULL;
+	entry->alias_words = NULL;
+	if (value == NULL)
+		return (0);
+	entry->alias = strdup(value);
+	entry->alias_buf = strdup(value);
+	entry->alias_words = calloc(strlen(value) / 2 + 2, sizeof(char *));
+	if (entry->alias == NULL || entry->alias_buf == NULL ||
+			entry->alias_words == NULL)
+		return (-1);
+	entry->alias_words[n] = strtok_r(entry->alias_buf, " \t", &save);
+	while (entry->alias_words[n] != NULL)
+		entry->alias_words[++n] = strtok_r(NULL, " \t", &save);
+	return (0);
+}
+
+/**
+ * print_aliases - Prints every alias as name='value'.
+ **/
+void print_aliases(void)
+{
+	def_entry *entry;
+	int i;
+
+	for (i = 0; i < DEF_TABLE_SIZE; i++)
+	{
+		for (entry = def_table[i]; entry != NULL; entry = entry->next)
+		{
+			if (entry->alias != NULL)
+				printf("%s='%s'\n", entry->name, entry->alias);
+		}
+	}
+	fflush(stdout);
+}
@@ -0,0 +1,102 @@
+#include "shell.h"
+
+static char **positional_args;
+static char *shell_name;
+
+/**
+ * set_shell_name - Sets the value of $0.
+ * @name: The name of the shell or script; it is not copied.
+ **/
+void set_shell_name(char *name)
+{
+	shell_name = name;
+}
+
+/**
+ * swap_positional - Replaces the positional parameters ($1, $2, ...).
+ * @args: NULL-terminated array of the new parameters, or NULL.
+ * Return: The previous parameters, to be restored by the caller.
+ **/
+char **swap_positional(char **args)
+{
+	char **old = positional_args;
+
+	positional_args = args;
+	return (old);
+}
+
+/**
+ * get_positional - Retrieves a positional parameter.
+ * @n: The parameter number; 0 gives the shell name ($0).
+ * Return: The parameter, or NULL if it is not set.
+ **/
+char *get_positional(int n)
+{
+	int i;
+
+	if (n == 0)
+		return (shell_name);
+	if (positional_args == NULL || n < 1)
+		return (NULL);
+	for (i = 0; i < n - 1 && positional_args[i] != NULL; i++)
+		;
+	return (positional_args[i]);
+}
+
+/**
+ * count_positional - Counts the positional parameters.
+ * Return: The value of $#.
+ **/
+int count_positional(void)
+{
+	int n = 0;
+
+	while (positional_args != NULL && positional_args[n] != NULL)
+		n++;
+	return (n);
+}
+
+/**
+ * run_definition - Runs a command through an alias or function.
+ * @args: The command words.
+ * @argv: The arguments that were passed to the shell.
+ * @data: A pointer to the shell data
+ * @env: The environment variables array
+ * Return: 1 if args[0] named an alias or function and was run, 0 if the
+ * caller should fall back to builtins and PATH.
+ * Description: An alias is not expanded again while its own expansion
+ * runs, so "alias ls='ls -F'" doesn't recurse.
+ **/
+int run_definition(char **args, char *argv[], shell_data *data, char **env)
+{
+	def_entry *entry = def_lookup(args[0], 0);
+	char **words;
+	int i, n;
+
+	if (entry == NULL || (entry->func == NULL && entry->alias_words == NULL))
+		return (0);
+	if (entry->alias_words == NULL || entry->expanding)
+	{
+		if (entry->func == NULL)
+			return (0);
+		call_function(entry, args, argv, data, env);
+		return (1);
+	}
+	for (n = 0; entry->alias_words[n] != NULL; n++)
+		;
+	for (i = 1; args[i] != NULL; i++)
+		;
+	words = malloc(sizeof(char *) * (n + i));
+	if (words == NULL || n == 0)
+	{
+		free(words);
+		return (n == 0);
+	}
+	memcpy(words, entry->alias_words, sizeof(char *) * n);
+	memcpy(words + n, args + 1, sizeof(char *) * i);
+	entry->expanding = 1;
+	execute_cmd(words, argv, data, env);
+	entry->expanding = 0;
+	free(words);
+	return (1);
+}
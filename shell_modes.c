@@ -0,0 +1,117 @@
+#include "shell.h"
+
+/**
+ * print_usage - Prints the usage message for the shell's option modes.
+ * @argv: The arguments that were passed to the shell.
+ * Return: EXIT_FAILURE, so callers can return it directly.
+ **/
+int print_usage(char *argv[])
+{
+	const char *usage = " [-c COMMAND [NAME [ARG...]] | -s | "
+		"--daemon SOCKET | --client SOCKET (-c COMMAND | FILE)]\n";
+
+	write(STDERR_FILENO, "Usage: ", 7);
+	write(STDERR_FILENO, argv[0], strlen(argv[0]));
+	write(STDERR_FILENO, usage, strlen(usage));
+	return (EXIT_FAILURE);
+}
+
+/**
+ * run_command_stream - Executes every command read from a stream.
+ * @fp: The stream to read commands from.
+ * @argv: The arguments that were passed to the shell.
+ * @env: The environment variables array
+ * Return: The exit status of the last command, or of the command that
+ * stopped the stream under set -e.
+ * Description: Used by every non-interactive mode: no prompt is printed
+ * and history is off. Streams backed by a descriptor get a large
+ * fully-buffered reader so that piped scripts are read in big chunks
+ * instead of line by line.
+ **/
+int run_command_stream(FILE *fp, char *argv[], char **env)
+{
+	shell_data data = {NULL, HISTORY_OFF, 0, 0};
+
+	if (fileno(fp) != -1)
+		setvbuf(fp, NULL, _IOFBF, STREAM_BUFFER_SIZE);
+	read_and_execute_commands(fp, argv, data, env);
+	if (errexit_tripped())
+		return (errexit_tripped());
+	return (get_last_status());
+}
+
+/**
+ * run_command_string - Executes the commands held in a string.
+ * @cmd: The commands, separated by newlines or semicolons.
+ * @argv: The arguments that were passed to the shell.
+ * @env: The environment variables array
+ * Return: The exit status of the last command.
+ **/
+int run_command_string(char *cmd, char *argv[], char **env)
+{
+	FILE *fp;
+	int status;
+
+	fp = fmemopen(cmd, strlen(cmd), "r");
+	if (fp == NULL)
+	{
+		perror("fmemopen");
+		return (EXIT_FAILURE);
+	}
+	status = run_command_stream(fp, argv, env);
+	fclose(fp);
+	return (status);
+}
+
+/**
+ * dispatch_shell_mode - Runs the shell in the mode selected by its options.
+ * @argc: The number of command line arguments.
+ * @argv: The arguments that were passed to the shell.
+ * @data: The shell data structure.
+ * @env: The environment variables array
+ * Return: The exit status of the selected mode, or -1 if no option
+ * selecting a special mode was given and main should carry on with the
+ * interactive or file-based shell.
+ * Description: -c runs a command string; "-c COMMAND NAME ARG..." also
+ * sets $0 to NAME (used in error messages too) and $1... to the ARGs.
+ * -s (or no arguments with a non-terminal stdin) streams commands from
+ * stdin.
+ * Must be called by main before any startup work (history
+ * file, environment copy) so that modes which don't need it skip it.
+ **/
+int dispatch_shell_mode(int argc, char *argv[], shell_data *data, char **env)
+{
+	(void)data;
+	set_shell_name(argv[0]);
+	if (argc == 1 && !isatty(STDIN_FILENO))
+		return (run_command_stream(stdin, argv, env));
+	if (argc < 2)
+		return (-1);
+	if (strcmp(argv[1], "-c") == 0)
+	{
+		if (argc < 3)
+			return (print_usage(argv));
+		if (argc == 3)
+			return (run_command_string(argv[2], argv, env));
+		set_shell_name(argv[3]);
+		swap_positional(argv + 4);
+		return (run_command_string(argv[2], argv + 3, env));
+	}
+	if (strcmp(argv[1], "-s") == 0)
+		return (run_command_stream(stdin, argv, env));
+	if (strcmp(argv[1], "--daemon") == 0)
+	{
+		if (argc != 3)
+			return (print_usage(argv));
+		return (daemon_serve(argv[2], argv));
+	}
+	if (strcmp(argv[1], "--client") == 0)
+	{
+		if (argc == 5 && strcmp(argv[3], "-c") == 0)
+			return (daemon_client(argv[2], 'S', argv[4]));
+		if (argc == 4)
+			return (daemon_client(argv[2], 'F', argv[3]));
+		return (print_usage(argv));
+	}
+	return (-1);
+}